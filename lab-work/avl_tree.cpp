@@ -0,0 +1,601 @@
+/**
+ * @file avl_tree.cpp
+ * @brief Implementation of a self-balancing Binary Search Tree (AVL tree)
+ *
+ * The BST class in binary_search_tree.cpp degenerates into a linked list
+ * when keys arrive in sorted order: every insert and search walks the whole
+ * chain, so building the tree takes O(n^2) time. This file provides
+ * AVLTree, a drop-in variant with the same insert/search/inOrder interface
+ * plus erase. After every insertion or deletion the nodes on the changed
+ * path are rebalanced with rotations so that the heights of any node's two
+ * subtrees differ by at most one, which bounds the tree height by
+ * 1.44 * log2(n).
+ *
+ * Running the program with --benchmark inserts sorted keys into both trees
+ * and compares time and height.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+using namespace std;
+
+/**
+ * @struct Node
+ * @brief Represents a node in the AVL tree
+ *
+ * Each node contains an integer value, the height of its subtree and
+ * pointers to its left and right child nodes.
+ */
+struct Node
+{
+    int data;    ///< The value stored in the node
+    int height;  ///< Height of the subtree rooted at this node; a leaf has height 1
+    Node *left;  ///< Pointer to the left child node
+    Node *right; ///< Pointer to the right child node
+
+    /**
+     * @brief Construct a new Node object
+     * @param value The integer value to be stored in the node
+     */
+    Node(int value)
+    {
+        data = value;
+        height = 1;
+        left = nullptr;
+        right = nullptr;
+    }
+};
+
+/**
+ * @class AVLTree
+ * @brief Implements a height-balanced Binary Search Tree
+ *
+ * This class provides methods for inserting and erasing nodes, searching
+ * for values, and performing an in-order traversal of the tree, all in
+ * O(log n) time regardless of the insertion order.
+ */
+class AVLTree
+{
+private:
+    Node *root; ///< Pointer to the root node of the tree
+
+    /**
+     * @brief Returns the height of a subtree, 0 for an empty one
+     */
+    static int height(Node *node)
+    {
+        return node == nullptr ? 0 : node->height;
+    }
+
+    /**
+     * @brief Recomputes a node's height from its children
+     */
+    static void updateHeight(Node *node)
+    {
+        node->height = 1 + max(height(node->left), height(node->right));
+    }
+
+    /**
+     * @brief Returns the balance factor of a node: left height minus right height
+     */
+    static int balanceFactor(Node *node)
+    {
+        return height(node->left) - height(node->right);
+    }
+
+    /**
+     * @brief Rotates a subtree to the right
+     * @param node The subtree root, whose left child becomes the new root
+     * @return Node* The new subtree root
+     */
+    static Node *rotateRight(Node *node)
+    {
+        Node *pivot = node->left;
+        node->left = pivot->right;
+        pivot->right = node;
+        updateHeight(node);
+        updateHeight(pivot);
+        return pivot;
+    }
+
+    /**
+     * @brief Rotates a subtree to the left
+     * @param node The subtree root, whose right child becomes the new root
+     * @return Node* The new subtree root
+     */
+    static Node *rotateLeft(Node *node)
+    {
+        Node *pivot = node->right;
+        node->right = pivot->left;
+        pivot->left = node;
+        updateHeight(node);
+        updateHeight(pivot);
+        return pivot;
+    }
+
+    /**
+     * @brief Restores the AVL property at a node whose subtrees differ in height by at most two
+     * @param node The subtree root
+     * @return Node* The new subtree root after at most two rotations
+     */
+    static Node *rebalance(Node *node)
+    {
+        updateHeight(node);
+        int balance = balanceFactor(node);
+
+        if (balance > 1)
+        {
+            // Left-right case: first turn it into a left-left case
+            if (balanceFactor(node->left) < 0)
+            {
+                node->left = rotateLeft(node->left);
+            }
+            return rotateRight(node);
+        }
+        if (balance < -1)
+        {
+            // Right-left case: first turn it into a right-right case
+            if (balanceFactor(node->right) > 0)
+            {
+                node->right = rotateRight(node->right);
+            }
+            return rotateLeft(node);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Helper function to insert a new node recursively
+     * @param node The current node being examined
+     * @param value The value to be inserted
+     * @return Node* Pointer to the subtree root after insertion and rebalancing
+     */
+    Node *insert(Node *node, int value)
+    {
+        // If the subtree is empty, return a new node
+        if (node == nullptr)
+        {
+            return new Node(value);
+        }
+
+        if (value < node->data)
+        {
+            node->left = insert(node->left, value);
+        }
+        else if (value > node->data)
+        {
+            node->right = insert(node->right, value);
+        }
+        else
+        {
+            return node; // Duplicate values are ignored, as in BST
+        }
+
+        return rebalance(node);
+    }
+
+    /**
+     * @brief Helper function to erase a value recursively
+     * @param node The current node being examined
+     * @param value The value to be erased
+     * @param erased Set to true if the value was found
+     * @return Node* Pointer to the subtree root after deletion and rebalancing
+     */
+    Node *erase(Node *node, int value, bool &erased)
+    {
+        if (node == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (value < node->data)
+        {
+            node->left = erase(node->left, value, erased);
+        }
+        else if (value > node->data)
+        {
+            node->right = erase(node->right, value, erased);
+        }
+        else
+        {
+            erased = true;
+            if (node->left == nullptr || node->right == nullptr)
+            {
+                // Zero or one child: the child takes the node's place
+                Node *child = node->left != nullptr ? node->left : node->right;
+                delete node;
+                return child;
+            }
+
+            // Two children: copy the in-order successor here and erase it from the right subtree
+            Node *successor = node->right;
+            while (successor->left != nullptr)
+            {
+                successor = successor->left;
+            }
+            node->data = successor->data;
+            node->right = erase(node->right, successor->data, erased);
+        }
+
+        return rebalance(node);
+    }
+
+    /**
+     * @brief Helper function to search for a value
+     * @param node The subtree root
+     * @param value The value to search for
+     * @return true if the value is found, false otherwise
+     *
+     * Iterative, since the descent never needs to come back up.
+     */
+    bool search(Node *node, int value)
+    {
+        while (node != nullptr)
+        {
+            if (node->data == value)
+            {
+                return true;
+            }
+            node = value > node->data ? node->right : node->left;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Helper function for in-order traversal
+     * @param node The current node being visited
+     */
+    void inOrder(Node *node)
+    {
+        if (node != nullptr)
+        {
+            inOrder(node->left);
+            cout << node->data << " ";
+            inOrder(node->right);
+        }
+    }
+
+    /**
+     * @brief Helper function to delete every node of a subtree
+     * @param node The subtree root
+     */
+    void destroy(Node *node)
+    {
+        if (node != nullptr)
+        {
+            destroy(node->left);
+            destroy(node->right);
+            delete node;
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new AVLTree object
+     *
+     * Initializes an empty tree
+     */
+    AVLTree()
+    {
+        root = nullptr;
+    }
+
+    /**
+     * @brief Destroy the AVLTree object, freeing every node
+     *
+     * Recursion is safe here because the height is O(log n).
+     */
+    ~AVLTree()
+    {
+        destroy(root);
+    }
+
+    AVLTree(const AVLTree &) = delete;
+    AVLTree &operator=(const AVLTree &) = delete;
+
+    /**
+     * @brief Insert a new value into the tree
+     * @param value The value to be inserted
+     */
+    void insert(int value)
+    {
+        root = insert(root, value);
+    }
+
+    /**
+     * @brief Erase a value from the tree
+     * @param value The value to be erased
+     * @return true if the value was present, false otherwise
+     */
+    bool erase(int value)
+    {
+        bool erased = false;
+        root = erase(root, value, erased);
+        return erased;
+    }
+
+    /**
+     * @brief Search for a value in the tree
+     * @param value The value to search for
+     * @return true if the value is found, false otherwise
+     */
+    bool search(int value)
+    {
+        return search(root, value);
+    }
+
+    /**
+     * @brief Perform an in-order traversal of the tree
+     *
+     * Prints the values of the tree in ascending order
+     */
+    void inOrder()
+    {
+        inOrder(root);
+        cout << endl;
+    }
+
+    /**
+     * @brief Returns the height of the tree
+     * @return The number of nodes on the longest root-to-leaf path, 0 if empty
+     */
+    int height()
+    {
+        return height(root);
+    }
+};
+
+/**
+ * @class UnbalancedBST
+ * @brief An unbalanced BST like the one of binary_search_tree.cpp, reproduced for the benchmark
+ *
+ * Plain recursive insert and search; it also tracks its height and frees its
+ * nodes with an explicit stack so the benchmark can tear down degenerate trees.
+ */
+class UnbalancedBST
+{
+private:
+    Node *root; ///< Pointer to the root node of the tree
+
+    /**
+     * @brief Recursive insert, ignoring duplicates as BST::insert does
+     */
+    Node *insert(Node *node, int value)
+    {
+        if (node == nullptr)
+        {
+            return new Node(value);
+        }
+        if (value < node->data)
+        {
+            node->left = insert(node->left, value);
+        }
+        else if (value > node->data)
+        {
+            node->right = insert(node->right, value);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Recursive search
+     */
+    bool search(Node *node, int value)
+    {
+        if (node == nullptr)
+        {
+            return false;
+        }
+        if (node->data == value)
+        {
+            return true;
+        }
+        if (value > node->data)
+        {
+            return search(node->right, value);
+        }
+        return search(node->left, value);
+    }
+
+public:
+    /**
+     * @brief Construct an empty tree
+     */
+    UnbalancedBST()
+    {
+        root = nullptr;
+    }
+
+    /**
+     * @brief Free every node without recursion
+     */
+    ~UnbalancedBST()
+    {
+        // Rotate left children up until the tree is a right-leaning list, deleting as we go
+        while (root != nullptr)
+        {
+            if (root->left != nullptr)
+            {
+                Node *left = root->left;
+                root->left = left->right;
+                left->right = root;
+                root = left;
+            }
+            else
+            {
+                Node *next = root->right;
+                delete root;
+                root = next;
+            }
+        }
+    }
+
+    UnbalancedBST(const UnbalancedBST &) = delete;
+    UnbalancedBST &operator=(const UnbalancedBST &) = delete;
+
+    /**
+     * @brief Insert a new value into the tree
+     */
+    void insert(int value)
+    {
+        root = insert(root, value);
+    }
+
+    /**
+     * @brief Search for a value in the tree
+     */
+    bool search(int value)
+    {
+        return search(root, value);
+    }
+
+    /**
+     * @brief Returns the length of the right spine, the height of a tree built from ascending keys
+     */
+    int height()
+    {
+        // Sorted inserts build a right spine; count it without recursion
+        int h = 0;
+        for (Node *node = root; node != nullptr; node = node->right)
+        {
+            h++;
+        }
+        return h;
+    }
+};
+
+/**
+ * @brief Inserts 0..n-1 in ascending order and then searches for every key
+ * @param tree The tree to fill
+ * @param n The number of keys
+ * @param insertMs Set to the time spent inserting, in milliseconds
+ * @param searchMs Set to the time spent searching, in milliseconds
+ * @return true if every key was found
+ */
+template <typename Tree>
+bool runSortedInserts(Tree &tree, int n, double &insertMs, double &searchMs)
+{
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++)
+    {
+        tree.insert(i);
+    }
+    auto middle = chrono::steady_clock::now();
+    bool allFound = true;
+    for (int i = 0; i < n; i++)
+    {
+        allFound = tree.search(i) && allFound;
+    }
+    auto end = chrono::steady_clock::now();
+
+    insertMs = chrono::duration<double, milli>(middle - start).count();
+    searchMs = chrono::duration<double, milli>(end - middle).count();
+    return allFound;
+}
+
+/**
+ * @brief Compares the unbalanced BST and the AVL tree on sorted insertions
+ * @param maxUnbalanced The largest key count tried on the unbalanced tree
+ * @return 0 if every search succeeded, 1 otherwise
+ *
+ * The unbalanced tree is stopped at maxUnbalanced keys because each of its
+ * inserts and searches walks the whole right spine, and its recursion would
+ * overflow the stack not far above 100k keys.
+ */
+int runBenchmark(int maxUnbalanced)
+{
+    bool allFound = true;
+    cout << "tree\tkeys\theight\tinsert ms\tsearch ms" << endl;
+    for (int n = 1000; n <= 1000000; n *= 10)
+    {
+        double insertMs, searchMs;
+        if (n <= maxUnbalanced)
+        {
+            UnbalancedBST bst;
+            allFound = runSortedInserts(bst, n, insertMs, searchMs) && allFound;
+            cout << "BST\t" << n << "\t" << bst.height() << "\t" << insertMs << "\t\t" << searchMs << endl;
+        }
+        else
+        {
+            cout << "BST\t" << n << "\t" << n << "\tskipped (O(n^2) inserts, recursion as deep as the tree)" << endl;
+        }
+
+        AVLTree avl;
+        allFound = runSortedInserts(avl, n, insertMs, searchMs) && allFound;
+        cout << "AVL\t" << n << "\t" << avl.height() << "\t" << insertMs << "\t\t" << searchMs << endl;
+    }
+    return allFound ? 0 : 1;
+}
+
+/**
+ * @brief Main function to demonstrate the AVL tree
+ * @param argc Number of command-line arguments
+ * @param argv Pass --benchmark [maxUnbalanced] to compare with the unbalanced BST instead
+ * @return int Exit status of the program
+ */
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && string(argv[1]) == "--benchmark")
+    {
+        return runBenchmark(argc > 2 ? atoi(argv[2]) : 10000);
+    }
+
+    // Create a new AVL tree
+    AVLTree tree;
+
+    // Insert values into the tree
+    tree.insert(50);
+    tree.insert(30);
+    tree.insert(20);
+    tree.insert(40);
+    tree.insert(70);
+    tree.insert(60);
+    tree.insert(80);
+
+    // Perform in-order traversal
+    cout << "In-order traversal of the AVL tree: ";
+    tree.inOrder();
+
+    // Demonstrate search functionality
+    int valueToSearch = 40;
+    if (tree.search(valueToSearch))
+    {
+        cout << valueToSearch << " found in the AVL tree." << endl;
+    }
+    else
+    {
+        cout << valueToSearch << " not found in the AVL tree." << endl;
+    }
+
+    // Demonstrate erase functionality
+    tree.erase(30);
+    cout << "In-order traversal after erasing 30: ";
+    tree.inOrder();
+
+    // Sorted keys, the worst case for the unbalanced BST, still give a logarithmic height
+    AVLTree sortedTree;
+    for (int i = 0; i < 1000000; i++)
+    {
+        sortedTree.insert(i);
+    }
+    cout << "Height after inserting 1000000 sorted keys: " << sortedTree.height() << endl;
+
+    return 0;
+}
+
+/**
+ * Usage Instructions:
+ * 1. Compile the program using a C++ compiler (e.g., g++ -O2 avl_tree.cpp -o avl_tree)
+ * 2. Run the compiled executable (e.g., ./avl_tree)
+ * 3. The program will display the tree before and after an erase, and the height
+ *    of a tree built from one million sorted keys
+ *
+ * To compare with the unbalanced BST on sorted insertions, run ./avl_tree --benchmark [maxUnbalanced]
+ *
+ * To use the AVL tree in your own code:
+ * 1. Include the Node struct and AVLTree class in your program
+ * 2. Create an AVLTree object and use insert, erase, search and inOrder as with BST
+ */
@@ -4,22 +4,72 @@
  *
  * This file contains the implementation of a Binary Search Tree, including
  * node structure, tree operations, and a demonstration in the main function.
+ *
+ * Besides membership, the tree answers ordered queries: lowerBound and
+ * upperBound, rangeScan over the keys in [low, high], and rank/select by
+ * position. Every node stores the size of its subtree, so rank and select
+ * take one root-to-leaf walk instead of an in-order traversal.
+ *
+ * A tree can also be bulk-loaded from an array with buildFrom: the keys are
+ * sorted if needed, then laid out in key order in one allocation and linked
+ * into a perfectly balanced tree in O(n). Running the program with
+ * --benchmark compares this with inserting the keys one at a time.
+ *
+ * Nodes come from a NodePool (node_pool.h) rather than one new per node, and
+ * destroying the tree releases the pool's slabs without walking the nodes.
+ * Running the program with --allocator compares this with new per node.
+ *
+ * searchBatch looks up many keys at once with their descents interleaved:
+ * each step of one lookup prefetches its next node, and the other lookups
+ * take their steps while that node is on its way from memory. Running the
+ * program with --batch compares it with calling search in a loop.
+ *
+ * save writes the tree to a flat file of fixed-size node records that refer
+ * to their children by record index, behind a versioned header with a
+ * checksum. load rebuilds a BST from such a file without comparing keys,
+ * and MappedBST memory-maps it read-only and searches it in place, so a
+ * restart needs no inserts at all. Running the program with --persist
+ * times the three.
  */
 
+#include "generic_sort.h"
+#include "node_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 using namespace std;
 
+const int BATCH_LANES = 16; ///< Lookups searchBatch keeps in flight at once, about the misses a core can overlap
+
 /**
  * @struct Node
  * @brief Represents a node in the Binary Search Tree
  *
- * Each node contains an integer value and pointers to its left and right child nodes.
+ * Each node contains an integer value, pointers to its left and right child
+ * nodes, and the number of nodes in its subtree.
  */
 struct Node
 {
     int data;    ///< The value stored in the node
     Node *left;  ///< Pointer to the left child node
     Node *right; ///< Pointer to the right child node
+    int size;    ///< Number of nodes in the subtree rooted here, this one included
 
     /**
      * @brief Construct a new Node object
@@ -30,75 +80,193 @@ struct Node
         data = value;
         left = nullptr;
         right = nullptr;
+        size = 1;
     }
 };
 
+const char INDEX_MAGIC[8] = {'B', 'S', 'T', 'I', 'N', 'D', 'E', 'X'}; ///< First bytes of every index file
+const uint32_t INDEX_VERSION = 1;                                      ///< Format version written by save
+const uint32_t INDEX_BYTE_ORDER = 0x01020304;                          ///< Reads differently on the other byte order
+const int32_t NO_CHILD = -1;                                           ///< Child index of a missing child
+
 /**
- * @class BST
- * @brief Implements the Binary Search Tree data structure
+ * @struct IndexHeader
+ * @brief The header at the start of an index file
+ */
+struct IndexHeader
+{
+    char magic[8];      ///< INDEX_MAGIC
+    uint32_t version;   ///< INDEX_VERSION
+    uint32_t byteOrder; ///< INDEX_BYTE_ORDER as written by the saving machine
+    uint64_t count;     ///< Number of node records that follow
+    uint64_t checksum;  ///< FNV-1a hash of the node records
+};
+
+/**
+ * @struct IndexNode
+ * @brief One node of an index file, 16 bytes
  *
- * This class provides methods for inserting nodes, searching for values,
- * and performing an in-order traversal of the tree.
+ * Records are in pre-order, so the root is record 0, a left child is always
+ * the next record and a right child follows the whole left subtree.
  */
-class BST
+struct IndexNode
 {
-private:
-    Node *root; ///< Pointer to the root node of the tree
+    int32_t data;  ///< The value stored in the node
+    int32_t left;  ///< Record index of the left child, or NO_CHILD
+    int32_t right; ///< Record index of the right child, or NO_CHILD
+    int32_t size;  ///< Number of nodes in the subtree rooted here
+};
 
-    /**
-     * @brief Helper function to insert a new node recursively
-     * @param node The current node being examined
-     * @param value The value to be inserted
-     * @return Node* Pointer to the current node after insertion
-     */
-    Node *insert(Node *node, int value)
+/**
+ * @brief Computes the 64-bit FNV-1a hash of a block of memory
+ * @param data The bytes to hash
+ * @param length The number of bytes
+ * @return The hash
+ */
+uint64_t fnv1a64(const void *data, size_t length)
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++)
     {
-        // If the tree is empty, return a new node
-        if (node == nullptr)
-        {
-            return new Node(value);
-        }
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
 
-        // Otherwise, recur down the tree
-        if (value < node->data)
+/**
+ * @brief Checks that a header matches this format and machine
+ * @param header The header read from a file
+ * @return true if the magic, version and byte order are as save writes them
+ */
+bool isValidIndexHeader(const IndexHeader &header)
+{
+    return memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0 && header.version == INDEX_VERSION &&
+           header.byteOrder == INDEX_BYTE_ORDER && header.count <= (uint64_t)INT32_MAX;
+}
+
+/**
+ * @brief Checks the checksum and the tree shape of the node records of a file
+ * @param header The header of the file
+ * @param records The node records
+ * @return true if the records hash to the checksum and form one tree in pre-order
+ *
+ * The shape check makes every record the child of exactly one parent, so a
+ * damaged file that happens to pass the checksum still cannot make load
+ * link a node twice.
+ */
+bool isValidIndex(const IndexHeader &header, const IndexNode *records)
+{
+    int64_t n = (int64_t)header.count;
+    if (fnv1a64(records, n * sizeof(IndexNode)) != header.checksum)
+    {
+        return false;
+    }
+    if (n > 0 && records[0].size != n)
+    {
+        return false;
+    }
+    for (int64_t i = 0; i < n; i++)
+    {
+        const IndexNode &node = records[i];
+        int64_t leftSize = node.left == NO_CHILD ? 0 : (node.left == i + 1 && i + 1 < n ? records[i + 1].size : -1);
+        if (leftSize < 0 || node.size < 1 || i + node.size > n)
         {
-            node->left = insert(node->left, value);
+            return false;
         }
-        else if (value > node->data)
+        int64_t rightSize =
+            node.right == NO_CHILD ? 0
+                                   : (node.right == i + 1 + leftSize && node.right < n ? records[node.right].size : -1);
+        if (rightSize < 0 || node.size != 1 + leftSize + rightSize)
         {
-            node->right = insert(node->right, value);
+            return false;
         }
+    }
+    return true;
+}
 
-        // Return the unchanged node pointer
-        return node;
+/**
+ * @class BasicBST
+ * @brief Implements the Binary Search Tree data structure
+ *
+ * This class provides methods for inserting nodes, searching for values,
+ * and performing an in-order traversal of the tree.
+ *
+ * @tparam NodeAllocator Where the nodes come from: NodePool<Node> or
+ *         HeapNodeAllocator<Node> from node_pool.h. Use BST for the pooled tree.
+ */
+template <typename NodeAllocator>
+class BasicBST
+{
+private:
+    Node *root;          ///< Pointer to the root node of the tree
+    NodeAllocator nodes; ///< Allocates and frees the nodes of this tree
+
+    /**
+     * @brief Returns the size of a subtree, 0 for an empty one
+     */
+    static int sizeOf(Node *node)
+    {
+        return node == nullptr ? 0 : node->size;
     }
 
     /**
-     * @brief Helper function to search for a value recursively
-     * @param node The current node being examined
-     * @param value The value to search for
-     * @return true if the value is found, false otherwise
+     * @brief Helper function to visit the keys of a subtree that lie in [low, high]
+     * @param node The root of the subtree
+     * @param low The smallest key of the range
+     * @param high The largest key of the range
+     * @param visit The function to call with each key
+     *
+     * Skips a left subtree when the node is not above low and a right subtree
+     * when it is not below high, so only O(height + k) nodes are touched for
+     * k results. Iterative with an explicit stack, so a degenerate tree
+     * cannot overflow the call stack.
      */
-    bool search(Node *node, int value)
+    template <typename Visitor>
+    void rangeScan(Node *node, int low, int high, Visitor &visit)
     {
-        // Base case: root is null or value is present at root
-        if (node == nullptr)
-        {
-            return false;
-        }
-        if (node->data == value)
+        vector<Node *> stack;
+        while (node != nullptr || !stack.empty())
         {
-            return true;
+            // Descend left while the left subtree can hold keys >= low
+            while (node != nullptr)
+            {
+                stack.push_back(node);
+                node = node->data > low ? node->left : nullptr;
+            }
+            node = stack.back();
+            stack.pop_back();
+            if (node->data >= low && node->data <= high)
+            {
+                visit(node->data);
+            }
+            node = node->data < high ? node->right : nullptr;
         }
+    }
 
-        // Value is greater than root's value
-        if (value > node->data)
+    /**
+     * @brief Helper function to build a balanced subtree of keys[low..high]
+     * @param keys The keys in ascending order
+     * @param low The index of the first key
+     * @param high The index of the last key
+     * @return Node* The subtree root, holding the middle key, or nullptr if low > high
+     *
+     * Creates the nodes in key order, so after nodes.reserve they occupy
+     * consecutive slots.
+     */
+    Node *buildBalanced(const vector<int> &keys, int low, int high)
+    {
+        if (low > high)
         {
-            return search(node->right, value);
+            return nullptr;
         }
-
-        // Value is less than root's value
-        return search(node->left, value);
+        int mid = low + (high - low) / 2;
+        Node *left = buildBalanced(keys, low, mid - 1);
+        Node *node = nodes.create(keys[mid]);
+        node->left = left;
+        node->right = buildBalanced(keys, mid + 1, high);
+        node->size = high - low + 1;
+        return node;
     }
 
     /**
@@ -121,18 +289,179 @@ public:
      *
      * Initializes an empty Binary Search Tree
      */
-    BST()
+    BasicBST()
+    {
+        root = nullptr;
+    }
+
+    /**
+     * @brief Destroy the BST object, freeing every node
+     */
+    ~BasicBST()
     {
+        clear();
+    }
+
+    BasicBST(const BasicBST &) = delete;
+    BasicBST &operator=(const BasicBST &) = delete;
+
+    /**
+     * @brief Take over the nodes of another tree, leaving it empty
+     */
+    BasicBST(BasicBST &&other) noexcept : root(other.root), nodes(move(other.nodes))
+    {
+        other.root = nullptr;
+    }
+
+    /**
+     * @brief Free this tree's nodes and take over those of another tree
+     */
+    BasicBST &operator=(BasicBST &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            root = other.root;
+            nodes = move(other.nodes);
+            other.root = nullptr;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Remove every key, freeing the nodes
+     *
+     * A NodePool frees all of them at once; otherwise the nodes are visited
+     * with an explicit stack, so deep trees do not overflow the call stack.
+     */
+    void clear()
+    {
+        if constexpr (NodeAllocator::RELEASES_ALL)
+        {
+            nodes.releaseAll();
+        }
+        else
+        {
+            vector<Node *> stack;
+            if (root != nullptr)
+            {
+                stack.push_back(root);
+            }
+            while (!stack.empty())
+            {
+                Node *node = stack.back();
+                stack.pop_back();
+                if (node->left != nullptr)
+                {
+                    stack.push_back(node->left);
+                }
+                if (node->right != nullptr)
+                {
+                    stack.push_back(node->right);
+                }
+                nodes.destroy(node);
+            }
+        }
         root = nullptr;
     }
 
+    /**
+     * @brief Replace the contents of the tree with the values of an array
+     * @param values The values; they need not be sorted, and duplicates are ignored
+     * @param n The number of values
+     *
+     * Sorts a copy of the values with sorting::introSort unless they are
+     * already in order, then creates the nodes in key order in one reserved
+     * block and links each range around its middle node. The result has the
+     * minimum height, and with a NodePool every subtree occupies a contiguous
+     * block of memory.
+     *
+     * @note Time Complexity: O(n) for sorted input, O(n log n) otherwise.
+     */
+    void buildFrom(const int values[], int n)
+    {
+        vector<int> keys(values, values + n);
+        if (!is_sorted(keys.begin(), keys.end()))
+        {
+            sorting::introSort(keys.begin(), keys.end());
+        }
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
+
+        clear();
+        nodes.reserve(keys.size());
+        root = buildBalanced(keys, 0, (int)keys.size() - 1);
+    }
+
     /**
      * @brief Insert a new value into the Binary Search Tree
      * @param value The value to be inserted
      */
     void insert(int value)
     {
-        root = insert(root, value);
+        // Walk down to the empty link where the value belongs; a duplicate changes nothing
+        Node **link = &root;
+        while (*link != nullptr)
+        {
+            if ((*link)->data == value)
+            {
+                return;
+            }
+            link = value < (*link)->data ? &(*link)->left : &(*link)->right;
+        }
+        *link = nodes.create(value);
+
+        // Count the new node in every subtree on the path above it
+        for (Node *node = root; node != *link; node = value < node->data ? node->left : node->right)
+        {
+            node->size++;
+        }
+    }
+
+    /**
+     * @brief Remove a value from the Binary Search Tree and free its node
+     * @param value The value to be removed
+     * @return true if the value was removed, false if it was not present
+     *
+     * A node with two children takes the key of its in-order successor, the
+     * leftmost node of its right subtree, and the successor is unlinked
+     * instead. Subtree sizes along the way are decremented.
+     */
+    bool erase(int value)
+    {
+        if (!search(value))
+        {
+            return false;
+        }
+
+        // Walk down to the node, counting the removal in every subtree on the path
+        Node **link = &root;
+        while ((*link)->data != value)
+        {
+            (*link)->size--;
+            link = value < (*link)->data ? &(*link)->left : &(*link)->right;
+        }
+        Node *node = *link;
+        node->size--;
+
+        if (node->left != nullptr && node->right != nullptr)
+        {
+            Node **successorLink = &node->right;
+            while ((*successorLink)->left != nullptr)
+            {
+                (*successorLink)->size--;
+                successorLink = &(*successorLink)->left;
+            }
+            Node *successor = *successorLink;
+            node->data = successor->data;
+            *successorLink = successor->right;
+            nodes.destroy(successor);
+        }
+        else
+        {
+            *link = node->left != nullptr ? node->left : node->right;
+            nodes.destroy(node);
+        }
+        return true;
     }
 
     /**
@@ -142,7 +471,316 @@ public:
      */
     bool search(int value)
     {
-        return search(root, value);
+        Node *node = root;
+        while (node != nullptr)
+        {
+            if (node->data == value)
+            {
+                return true;
+            }
+            node = value > node->data ? node->right : node->left;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Search for many values, overlapping the memory latency of their descents
+     * @param keys The values to search for
+     * @param n The number of values
+     * @param out Set out[i] to whether keys[i] is in the tree
+     *
+     * Keeps BATCH_LANES lookups in flight. Each pass advances every lookup by
+     * one level and prefetches the node it moves to, so by the time the pass
+     * comes back to it the node is usually in cache. A lookup that finishes
+     * hands its lane to the next key, so lanes stay busy however the depths
+     * of the lookups differ.
+     */
+    void searchBatch(const int *keys, size_t n, bool *out)
+    {
+        Node *current[BATCH_LANES]; ///< The node each lane compares next
+        size_t index[BATCH_LANES];  ///< The key each lane is looking up
+        size_t next = 0;
+        int active = 0;
+        while (active < BATCH_LANES && next < n)
+        {
+            current[active] = root;
+            index[active++] = next++;
+        }
+
+        while (active > 0)
+        {
+            for (int lane = 0; lane < active;)
+            {
+                Node *node = current[lane];
+                int key = keys[index[lane]];
+                if (node != nullptr && node->data != key)
+                {
+                    Node *child = key < node->data ? node->left : node->right;
+#if defined(__GNUC__) || defined(__clang__)
+                    __builtin_prefetch(child);
+#endif
+                    current[lane++] = child;
+                    continue;
+                }
+
+                // This lookup is done: start the next key in its lane, or close the lane
+                out[index[lane]] = node != nullptr;
+                if (next < n)
+                {
+                    current[lane] = root;
+                    index[lane++] = next++;
+                }
+                else
+                {
+                    active--;
+                    current[lane] = current[active];
+                    index[lane] = index[active];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Find the smallest key not less than value
+     * @param value The value to compare against
+     * @param result Set to the key if there is one
+     * @return true if such a key exists, false otherwise
+     */
+    bool lowerBound(int value, int &result)
+    {
+        bool found = false;
+        Node *node = root;
+        while (node != nullptr)
+        {
+            if (node->data >= value)
+            {
+                // A candidate; a smaller one may be on the left
+                result = node->data;
+                found = true;
+                node = node->left;
+            }
+            else
+            {
+                node = node->right;
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @brief Find the smallest key greater than value
+     * @param value The value to compare against
+     * @param result Set to the key if there is one
+     * @return true if such a key exists, false otherwise
+     */
+    bool upperBound(int value, int &result)
+    {
+        bool found = false;
+        Node *node = root;
+        while (node != nullptr)
+        {
+            if (node->data > value)
+            {
+                result = node->data;
+                found = true;
+                node = node->left;
+            }
+            else
+            {
+                node = node->right;
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @brief Calls visit(key) for every key in [low, high] in ascending order
+     * @param low The smallest key of the range
+     * @param high The largest key of the range
+     * @param visit The function to call with each key
+     */
+    template <typename Visitor>
+    void rangeScan(int low, int high, Visitor visit)
+    {
+        rangeScan(root, low, high, visit);
+    }
+
+    /**
+     * @brief Count the keys less than value
+     * @param value The value to compare against
+     * @return The number of keys less than value, which is the 0-based
+     *         position of value if it is present
+     */
+    int rank(int value)
+    {
+        int less = 0;
+        Node *node = root;
+        while (node != nullptr)
+        {
+            if (value > node->data)
+            {
+                // The node and its whole left subtree are smaller
+                less += sizeOf(node->left) + 1;
+                node = node->right;
+            }
+            else
+            {
+                node = node->left;
+            }
+        }
+        return less;
+    }
+
+    /**
+     * @brief Find the key at a position in ascending order
+     * @param k The 0-based position; 0 selects the smallest key
+     * @param result Set to the key if k is in range
+     * @return true if 0 <= k < count(), false otherwise
+     */
+    bool select(int k, int &result)
+    {
+        if (k < 0 || k >= sizeOf(root))
+        {
+            return false;
+        }
+        Node *node = root;
+        while (true)
+        {
+            int leftSize = sizeOf(node->left);
+            if (k < leftSize)
+            {
+                node = node->left;
+            }
+            else if (k == leftSize)
+            {
+                result = node->data;
+                return true;
+            }
+            else
+            {
+                k -= leftSize + 1;
+                node = node->right;
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the number of keys stored
+     */
+    int count()
+    {
+        return sizeOf(root);
+    }
+
+    /**
+     * @brief Write the tree to an index file that load or MappedBST can read
+     * @param path The file to create or overwrite
+     * @return true on success, false if the file could not be written
+     *
+     * Numbers the nodes in pre-order using the subtree sizes: the left child
+     * of record i is record i + 1 and the right child is record
+     * i + 1 + size(left). Records use the byte order of this machine.
+     */
+    bool save(const char *path)
+    {
+        vector<IndexNode> records;
+        records.reserve(sizeOf(root));
+        vector<Node *> stack;
+        if (root != nullptr)
+        {
+            stack.push_back(root);
+        }
+        while (!stack.empty())
+        {
+            Node *node = stack.back();
+            stack.pop_back();
+            int32_t index = (int32_t)records.size();
+            records.push_back({node->data, node->left != nullptr ? index + 1 : NO_CHILD,
+                               node->right != nullptr ? index + 1 + sizeOf(node->left) : NO_CHILD, node->size});
+
+            // Push right first so the left subtree is numbered first
+            if (node->right != nullptr)
+            {
+                stack.push_back(node->right);
+            }
+            if (node->left != nullptr)
+            {
+                stack.push_back(node->left);
+            }
+        }
+
+        IndexHeader header;
+        memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        header.version = INDEX_VERSION;
+        header.byteOrder = INDEX_BYTE_ORDER;
+        header.count = records.size();
+        header.checksum = fnv1a64(records.data(), records.size() * sizeof(IndexNode));
+
+        FILE *file = fopen(path, "wb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+        bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                       (records.empty() ||
+                        fwrite(records.data(), sizeof(IndexNode), records.size(), file) == records.size());
+        return fclose(file) == 0 && written;
+    }
+
+    /**
+     * @brief Replace the contents of the tree with those of an index file
+     * @param path The file written by save
+     * @return true on success; false if the file is missing, damaged or of
+     *         another version, in which case the tree is left unchanged
+     *
+     * Creates the nodes in record order, one reserved block with a NodePool,
+     * and links them by index. No key is compared.
+     */
+    bool load(const char *path)
+    {
+        FILE *file = fopen(path, "rb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+        IndexHeader header;
+        vector<IndexNode> records;
+        bool read = fread(&header, sizeof(header), 1, file) == 1 && isValidIndexHeader(header);
+
+        // The file must hold exactly count records; a damaged count must not
+        // make resize allocate gigabytes before fread fails
+        if (read)
+        {
+            long fileSize = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : -1;
+            read = fileSize >= 0 && (uint64_t)fileSize == sizeof(IndexHeader) + header.count * sizeof(IndexNode) &&
+                   fseek(file, sizeof(IndexHeader), SEEK_SET) == 0;
+        }
+        if (read)
+        {
+            records.resize(header.count);
+            read = records.empty() || fread(records.data(), sizeof(IndexNode), records.size(), file) == records.size();
+        }
+        fclose(file);
+        if (!read || !isValidIndex(header, records.data()))
+        {
+            return false;
+        }
+
+        clear();
+        nodes.reserve(records.size());
+        vector<Node *> created(records.size());
+        for (size_t i = 0; i < records.size(); i++)
+        {
+            created[i] = nodes.create(records[i].data);
+            created[i]->size = records[i].size;
+        }
+        for (size_t i = 0; i < records.size(); i++)
+        {
+            created[i]->left = records[i].left == NO_CHILD ? nullptr : created[records[i].left];
+            created[i]->right = records[i].right == NO_CHILD ? nullptr : created[records[i].right];
+        }
+        root = records.empty() ? nullptr : created[0];
+        return true;
     }
 
     /**
@@ -157,12 +795,463 @@ public:
     }
 };
 
+/**
+ * @brief The Binary Search Tree, with its nodes in a NodePool
+ */
+using BST = BasicBST<NodePool<Node>>;
+
+/**
+ * @class MappedBST
+ * @brief A read-only view of an index file, searched where it lies in memory
+ *
+ * On Linux the file is mapped with mmap, so opening it costs no reads and
+ * no allocations; pages are loaded as searches touch them and shared with
+ * other processes mapping the same file. Elsewhere the file is read into
+ * one buffer.
+ */
+class MappedBST
+{
+private:
+    const IndexHeader *header;    ///< The header at the start of the mapping, or nullptr if closed
+    const IndexNode *records;     ///< The node records after the header
+    void *mapping;                ///< The mapped region, or nullptr if the file was read into buffer
+    size_t mappedBytes;           ///< The length of the mapped region
+    vector<unsigned char> buffer; ///< The file contents when it is not mapped
+
+    /**
+     * @brief Unmaps the file, if one is open
+     */
+    void close()
+    {
+#ifdef __linux__
+        if (mapping != nullptr)
+        {
+            munmap(mapping, mappedBytes);
+        }
+#endif
+        header = nullptr;
+        records = nullptr;
+        mapping = nullptr;
+        mappedBytes = 0;
+        buffer.clear();
+    }
+
+public:
+    /**
+     * @brief Construct a view with no file open
+     */
+    MappedBST() : header(nullptr), records(nullptr), mapping(nullptr), mappedBytes(0) {}
+
+    /**
+     * @brief Destroy the view, unmapping the file
+     */
+    ~MappedBST()
+    {
+        close();
+    }
+
+    MappedBST(const MappedBST &) = delete;
+    MappedBST &operator=(const MappedBST &) = delete;
+
+    /**
+     * @brief Open an index file written by BST::save
+     * @param path The file
+     * @param verify true to check the checksum and tree shape, which reads the
+     *        whole file once; false to trust it and touch only the header
+     * @return true on success, false if the file is missing, damaged or of another version
+     */
+    bool open(const char *path, bool verify = true)
+    {
+        close();
+        const unsigned char *bytes = nullptr;
+        size_t length = 0;
+#ifdef __linux__
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size >= (off_t)sizeof(IndexHeader))
+        {
+            length = (size_t)info.st_size;
+            void *region = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (region != MAP_FAILED)
+            {
+                mapping = region;
+                mappedBytes = length;
+                bytes = static_cast<const unsigned char *>(region);
+            }
+        }
+        ::close(fd);
+#else
+        FILE *file = fopen(path, "rb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+        unsigned char chunk[1 << 16];
+        size_t got;
+        while ((got = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        {
+            buffer.insert(buffer.end(), chunk, chunk + got);
+        }
+        fclose(file);
+        bytes = buffer.data();
+        length = buffer.size();
+#endif
+        if (bytes == nullptr || length < sizeof(IndexHeader))
+        {
+            close();
+            return false;
+        }
+
+        header = reinterpret_cast<const IndexHeader *>(bytes);
+        records = reinterpret_cast<const IndexNode *>(bytes + sizeof(IndexHeader));
+        bool valid = isValidIndexHeader(*header) && length == sizeof(IndexHeader) + header->count * sizeof(IndexNode);
+        if (!valid || (verify && !isValidIndex(*header, records)))
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Search for a value in the mapped tree
+     * @param value The value to search for
+     * @return true if the value is found, false otherwise
+     *
+     * Only follows child indices that move forward within the file, so even
+     * an unverified damaged file cannot make the search loop or read past
+     * the mapping.
+     */
+    bool search(int value) const
+    {
+        int64_t n = header == nullptr ? 0 : (int64_t)header->count;
+        int64_t index = n > 0 ? 0 : NO_CHILD;
+        while (index != NO_CHILD)
+        {
+            const IndexNode &node = records[index];
+            if (node.data == value)
+            {
+                return true;
+            }
+            int64_t child = value < node.data ? node.left : node.right;
+            index = child > index && child < n ? child : NO_CHILD;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Returns the number of keys in the open file, 0 if none is open
+     */
+    int count() const
+    {
+        return header == nullptr ? 0 : (int)header->count;
+    }
+};
+
+/**
+ * @brief Times lookups of the given keys in a tree
+ * @param tree The tree
+ * @param queries The keys to look up
+ * @param found Set to the number of keys found
+ * @return The average time per lookup in nanoseconds
+ */
+template <typename Tree>
+double timeLookups(Tree &tree, const vector<int> &queries, long long &found)
+{
+    found = 0;
+    auto start = chrono::steady_clock::now();
+    for (int key : queries)
+    {
+        found += tree.search(key);
+    }
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(end - start).count() / (double)queries.size();
+}
+
+/**
+ * @brief Compares building a tree by repeated insert with buildFrom
+ * @param n The number of random keys
+ * @return 0 if both trees found the same keys, 1 otherwise
+ */
+int runBenchmark(int n)
+{
+    mt19937 generator(16);
+    vector<int> keys(n);
+    for (int &key : keys)
+    {
+        key = (int)(generator() >> 1);
+    }
+    vector<int> queries(n);
+    for (int i = 0; i < n; i++)
+    {
+        queries[i] = i % 2 == 0 ? keys[generator() % n] : (int)(generator() | 0x80000000u);
+    }
+
+    BST inserted;
+    auto start = chrono::steady_clock::now();
+    for (int key : keys)
+    {
+        inserted.insert(key);
+    }
+    auto end = chrono::steady_clock::now();
+    double insertMs = chrono::duration<double, milli>(end - start).count();
+
+    BST bulk;
+    start = chrono::steady_clock::now();
+    bulk.buildFrom(keys.data(), n);
+    end = chrono::steady_clock::now();
+    double bulkMs = chrono::duration<double, milli>(end - start).count();
+
+    long long insertedFound, bulkFound;
+    double insertedNs = timeLookups(inserted, queries, insertedFound);
+    double bulkNs = timeLookups(bulk, queries, bulkFound);
+
+    cout << "Repeated insert: built in " << insertMs << " ms, " << insertedNs << " ns/lookup" << endl;
+    cout << "buildFrom:       built in " << bulkMs << " ms, " << bulkNs << " ns/lookup" << endl;
+
+    bool agree = insertedFound == bulkFound && inserted.count() == bulk.count();
+    cout << "Results " << (agree ? "agree" : "DISAGREE") << " (" << bulk.count() << " distinct keys)" << endl;
+    return agree ? 0 : 1;
+}
+
+/**
+ * @brief Returns the resident set size of this process in bytes, or -1 if unavailable
+ */
+long long residentBytes()
+{
+#ifdef __linux__
+    FILE *statm = fopen("/proc/self/statm", "r");
+    long long pages = -1, resident = -1;
+    if (statm != nullptr)
+    {
+        if (fscanf(statm, "%lld %lld", &pages, &resident) != 2)
+        {
+            resident = -1;
+        }
+        fclose(statm);
+    }
+    return resident < 0 ? -1 : resident * sysconf(_SC_PAGESIZE);
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief Inserts keys into a new tree and reports insert rate, memory growth and destroy time
+ * @param name The label of the tree type
+ * @param keys The keys to insert
+ * @return The number of distinct keys in the tree
+ */
+template <typename Tree>
+int timeAllocatorInserts(const char *name, const vector<int> &keys)
+{
+    long long rssBefore = residentBytes();
+    Tree *tree = new Tree();
+    auto start = chrono::steady_clock::now();
+    for (int key : keys)
+    {
+        tree->insert(key);
+    }
+    auto inserted = chrono::steady_clock::now();
+    long long rssAfter = residentBytes();
+    int distinct = tree->count();
+    delete tree;
+    auto destroyed = chrono::steady_clock::now();
+
+    double insertSeconds = chrono::duration<double>(inserted - start).count();
+    cout << name << "\t" << keys.size() / insertSeconds / 1e6 << "\t\t";
+    if (rssBefore >= 0 && rssAfter >= 0)
+    {
+        cout << (double)(rssAfter - rssBefore) / distinct;
+    }
+    else
+    {
+        cout << "n/a";
+    }
+    cout << "\t\t" << chrono::duration<double, milli>(destroyed - inserted).count() << endl;
+    return distinct;
+}
+
+/**
+ * @brief Compares a tree with pooled nodes and one with a new per node
+ * @param n The number of random keys inserted
+ * @return 0 if both trees hold the same number of keys, 1 otherwise
+ *
+ * The pooled tree runs first: its slabs are returned to the operating
+ * system when it is destroyed, while freed malloc memory may be kept for
+ * reuse and would hide the growth of the second tree.
+ */
+int runAllocatorBenchmark(int n)
+{
+    mt19937 generator(17);
+    vector<int> keys(n);
+    for (int &key : keys)
+    {
+        key = (int)(generator() >> 1);
+    }
+
+    cout << "nodes\tM inserts/s\tRSS bytes/key\tdestroy ms" << endl;
+    int pooled = timeAllocatorInserts<BST>("pool", keys);
+    int heap = timeAllocatorInserts<BasicBST<HeapNodeAllocator<Node>>>("new", keys);
+    return pooled == heap ? 0 : 1;
+}
+
+/**
+ * @brief Compares searchBatch with calling search in a loop
+ * @param n The number of random keys in the tree
+ * @param batchSize The number of keys per searchBatch call
+ * @return 0 if both found the same keys, 1 otherwise
+ */
+int runBatchBenchmark(int n, int batchSize)
+{
+    mt19937 generator(21);
+    vector<int> keys(n);
+    for (int &key : keys)
+    {
+        key = (int)(generator() >> 1);
+    }
+    BST tree;
+    for (int key : keys)
+    {
+        tree.insert(key);
+    }
+
+    // Half the queries hit inserted keys, half miss
+    vector<int> queries(n);
+    for (int i = 0; i < n; i++)
+    {
+        queries[i] = i % 2 == 0 ? keys[generator() % n] : (int)(generator() | 0x80000000u);
+    }
+
+    vector<char> looped(n);
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++)
+    {
+        looped[i] = tree.search(queries[i]);
+    }
+    auto end = chrono::steady_clock::now();
+    double loopNs = chrono::duration<double, nano>(end - start).count() / n;
+
+    unique_ptr<bool[]> batched(new bool[n]);
+    start = chrono::steady_clock::now();
+    for (int first = 0; first < n; first += batchSize)
+    {
+        tree.searchBatch(queries.data() + first, min(batchSize, n - first), batched.get() + first);
+    }
+    end = chrono::steady_clock::now();
+    double batchNs = chrono::duration<double, nano>(end - start).count() / n;
+
+    bool agree = true;
+    for (int i = 0; i < n; i++)
+    {
+        agree = agree && (bool)looped[i] == batched[i];
+    }
+    cout << "search loop: " << loopNs << " ns/lookup" << endl;
+    cout << "searchBatch: " << batchNs << " ns/lookup in batches of " << batchSize << " (" << loopNs / batchNs
+         << "x faster)" << endl;
+    cout << "Results " << (agree ? "agree" : "DISAGREE") << endl;
+    return agree ? 0 : 1;
+}
+
+/**
+ * @brief Compares rebuilding a tree by insert with loading and mapping a saved index
+ * @param n The number of random keys in the tree
+ * @param path The index file to write; removed afterwards
+ * @return 0 if every tree found the same keys, 1 otherwise
+ */
+int runPersistBenchmark(int n, const char *path)
+{
+    mt19937 generator(22);
+    vector<int> keys(n);
+    for (int &key : keys)
+    {
+        key = (int)(generator() >> 1);
+    }
+    vector<int> queries(n);
+    for (int i = 0; i < n; i++)
+    {
+        queries[i] = i % 2 == 0 ? keys[generator() % n] : (int)(generator() | 0x80000000u);
+    }
+
+    BST tree;
+    auto start = chrono::steady_clock::now();
+    for (int key : keys)
+    {
+        tree.insert(key);
+    }
+    auto end = chrono::steady_clock::now();
+    cout << "Rebuild by insert: " << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+
+    start = chrono::steady_clock::now();
+    if (!tree.save(path))
+    {
+        cout << "Could not write " << path << endl;
+        return 1;
+    }
+    end = chrono::steady_clock::now();
+    cout << "save:              " << chrono::duration<double, milli>(end - start).count() << " ms, "
+         << sizeof(IndexHeader) + (size_t)tree.count() * sizeof(IndexNode) << " bytes" << endl;
+
+    BST loaded;
+    start = chrono::steady_clock::now();
+    bool loadedOk = loaded.load(path);
+    end = chrono::steady_clock::now();
+    cout << "load:              " << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+
+    MappedBST mapped, trusted;
+    start = chrono::steady_clock::now();
+    bool mappedOk = mapped.open(path);
+    end = chrono::steady_clock::now();
+    cout << "map and verify:    " << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+    start = chrono::steady_clock::now();
+    bool trustedOk = trusted.open(path, false);
+    end = chrono::steady_clock::now();
+    cout << "map unverified:    " << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+
+    long long treeFound, loadedFound, mappedFound;
+    double treeNs = timeLookups(tree, queries, treeFound);
+    double loadedNs = timeLookups(loaded, queries, loadedFound);
+    double mappedNs = timeLookups(mapped, queries, mappedFound);
+    cout << "Lookups: built " << treeNs << " ns, loaded " << loadedNs << " ns, mapped " << mappedNs << " ns" << endl;
+
+    remove(path);
+    bool agree = loadedOk && mappedOk && trustedOk && treeFound == loadedFound && treeFound == mappedFound;
+    cout << "Results " << (agree ? "agree" : "DISAGREE") << " (" << mappedFound << " found)" << endl;
+    return agree ? 0 : 1;
+}
+
 /**
  * @brief Main function to demonstrate the Binary Search Tree
+ * @param argc Number of command-line arguments
+ * @param argv Pass --benchmark [n] to compare repeated insert with buildFrom, or
+ *             --allocator [n] to compare pooled nodes with new per node, or
+ *             --batch [n] [batchSize] to compare searchBatch with search, or
+ *             --persist [n] [path] to time save, load and mapping, instead
  * @return int Exit status of the program
  */
-int main()
+int main(int argc, char *argv[])
 {
+    if (argc > 1 && string(argv[1]) == "--benchmark")
+    {
+        return runBenchmark(argc > 2 ? atoi(argv[2]) : 5000000);
+    }
+    if (argc > 1 && string(argv[1]) == "--allocator")
+    {
+        return runAllocatorBenchmark(argc > 2 ? atoi(argv[2]) : 5000000);
+    }
+    if (argc > 1 && string(argv[1]) == "--batch")
+    {
+        return runBatchBenchmark(argc > 2 ? atoi(argv[2]) : 5000000, argc > 3 ? max(1, atoi(argv[3])) : 4096);
+    }
+    if (argc > 1 && string(argv[1]) == "--persist")
+    {
+        return runPersistBenchmark(argc > 2 ? atoi(argv[2]) : 5000000, argc > 3 ? argv[3] : "bst_index.bin");
+    }
+
     // Create a new Binary Search Tree
     BST tree;
 
@@ -190,5 +1279,73 @@ int main()
         cout << valueToSearch << " not found in the BST." << endl;
     }
 
+    // Demonstrate ordered queries
+    int result = 0;
+    if (tree.lowerBound(45, result))
+    {
+        cout << "Smallest key >= 45: " << result << endl;
+    }
+    if (tree.upperBound(50, result))
+    {
+        cout << "Smallest key > 50: " << result << endl;
+    }
+    cout << "Keys in [35, 65]: ";
+    tree.rangeScan(35, 65, [](int key) { cout << key << " "; });
+    cout << endl;
+    if (tree.select(2, result))
+    {
+        cout << "Third smallest key: " << result << endl;
+    }
+    cout << "Keys less than 70: " << tree.rank(70) << " of " << tree.count() << endl;
+
+    // Look up several values in one batch
+    int batchKeys[] = {20, 25, 60, 90};
+    bool batchFound[4];
+    tree.searchBatch(batchKeys, 4, batchFound);
+    cout << "Batch lookup: ";
+    for (int i = 0; i < 4; i++)
+    {
+        cout << batchKeys[i] << (batchFound[i] ? " found" : " not found") << (i < 3 ? ", " : "\n");
+    }
+
+    // Demonstrate erase functionality
+    tree.erase(30);
+    cout << "In-order traversal after erasing 30: ";
+    tree.inOrder();
+
+    // Bulk-load a balanced tree from an unsorted array
+    int values[] = {90, 10, 50, 30, 70, 20, 80, 40, 60, 10};
+    BST bulkTree;
+    bulkTree.buildFrom(values, sizeof(values) / sizeof(values[0]));
+    cout << "In-order traversal of the bulk-loaded BST: ";
+    bulkTree.inOrder();
+
+    // Save the tree and search it in place from the file
+    MappedBST mapped;
+    if (bulkTree.save("bst_demo.bin") && mapped.open("bst_demo.bin"))
+    {
+        cout << "Mapped index holds " << mapped.count() << " keys; 70 " << (mapped.search(70) ? "found" : "not found")
+             << ", 75 " << (mapped.search(75) ? "found" : "not found") << endl;
+    }
+    remove("bst_demo.bin");
+
+    // Move the tree to a new owner without copying its nodes
+    BST owner = move(bulkTree);
+    cout << "Moved tree holds " << owner.count() << " keys, the source " << bulkTree.count() << endl;
+
     return 0;
 }
+
+/**
+ * Usage Instructions:
+ * 1. Compile the program with C++17 (e.g., g++ -std=c++17 -O2 binary_search_tree.cpp -o binary_search_tree),
+ *    with generic_sort.h and node_pool.h in the same directory
+ * 2. Run the compiled executable (e.g., ./binary_search_tree)
+ * 3. The program will display the keys in order, a search result, the
+ *    results of the ordered queries and a bulk-loaded tree
+ *
+ * To compare repeated insert with buildFrom, run ./binary_search_tree --benchmark [n]
+ * To compare pooled nodes with new per node, run ./binary_search_tree --allocator [n]
+ * To compare searchBatch with search, run ./binary_search_tree --batch [n] [batchSize]
+ * To time save, load and mapping against rebuilding, run ./binary_search_tree --persist [n] [path]
+ */
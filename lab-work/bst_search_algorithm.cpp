@@ -5,11 +5,128 @@
  * This file contains the implementation of a Binary Search Tree data structure
  * with methods for insertion and searching. It demonstrates the basic operations
  * of a BST and provides a simple interface for users to interact with the tree.
+ *
+ * A tree that is built once and then only searched can be frozen into an
+ * EytzingerTree: the keys in breadth-first order in one array, 4 bytes per
+ * key instead of a 24-byte Node, searched without pointer chasing. Running
+ * the program with --benchmark compares the two on random keys.
  */
 
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
 using namespace std;
 
+/**
+ * @class EytzingerTree
+ * @brief A read-only search tree stored implicitly in an array
+ *
+ * Slot 1 holds the root and the children of slot k are slots 2k and 2k + 1,
+ * the layout of a binary heap. The top levels of the tree share a few cache
+ * lines, and the 16 descendants four levels below slot k are the 64-byte
+ * aligned slots 16k to 16k + 15, so a search prefetches that line while it
+ * compares the next four levels, as long as it lies inside the array. The descent has no data-dependent branch:
+ * each step moves to 2k + (key < value).
+ */
+class EytzingerTree
+{
+private:
+    int *layout; ///< Keys in breadth-first order in slots 1 to n; slot 0 is unused
+    int n;       ///< Number of keys
+
+    /**
+     * @brief Helper function to fill the subtree at slot k with the next keys of sorted
+     * @param sorted The keys in ascending order
+     * @param next The index of the next key of sorted to place; advanced past the subtree
+     * @param k The slot of the subtree root
+     */
+    void build(const int sorted[], int &next, int k)
+    {
+        if (k <= n)
+        {
+            build(sorted, next, 2 * k);
+            layout[k] = sorted[next++];
+            build(sorted, next, 2 * k + 1);
+        }
+    }
+
+public:
+    /**
+     * @brief Construct an EytzingerTree from a sorted array
+     * @param sorted The keys in ascending order, without duplicates
+     * @param count The number of keys
+     */
+    EytzingerTree(const int sorted[], int count)
+    {
+        n = count;
+        layout = static_cast<int *>(operator new[](sizeof(int) * (n + 1), align_val_t(64)));
+        layout[0] = 0;
+        int next = 0;
+        build(sorted, next, 1);
+    }
+
+    /**
+     * @brief Destroy the EytzingerTree object, freeing the array
+     */
+    ~EytzingerTree()
+    {
+        operator delete[](layout, align_val_t(64));
+    }
+
+    EytzingerTree(const EytzingerTree &) = delete;
+    EytzingerTree &operator=(const EytzingerTree &) = delete;
+
+    /**
+     * @brief Search for a value in the tree
+     * @param value The value to search for
+     * @return true if the value is found, false otherwise
+     */
+    bool search(int value) const
+    {
+        int k = 1;
+        while (k <= n)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            // Only form the address while it is inside the array; the last four levels need no prefetch
+            if (16 * (long long)k <= n)
+            {
+                __builtin_prefetch(layout + 16 * (long long)k);
+            }
+#endif
+            k = 2 * k + (layout[k] < value);
+        }
+
+        // k went right at every step below the smallest key >= value, then left
+        // once past it; dropping those trailing right turns recovers its slot
+        while (k & 1)
+        {
+            k >>= 1;
+        }
+        k >>= 1;
+        return k != 0 && layout[k] == value;
+    }
+
+    /**
+     * @brief Returns the number of keys stored
+     */
+    int count() const
+    {
+        return n;
+    }
+
+    /**
+     * @brief Returns the bytes used by the array
+     */
+    long long memoryBytes() const
+    {
+        return (long long)sizeof(int) * (n + 1);
+    }
+};
+
 /**
  * @struct Node
  * @brief Represents a node in the Binary Search Tree
@@ -97,6 +214,30 @@ private:
         return search(node->left, value);
     }
 
+    /**
+     * @brief Helper function to append the keys of a subtree in ascending order
+     * @param node The root of the subtree
+     * @param keys The array the keys are appended to
+     *
+     * Iterative with an explicit stack, so a degenerate tree cannot overflow the call stack.
+     */
+    void collect(Node *node, vector<int> &keys)
+    {
+        vector<Node *> stack;
+        while (node != nullptr || !stack.empty())
+        {
+            while (node != nullptr)
+            {
+                stack.push_back(node);
+                node = node->left;
+            }
+            node = stack.back();
+            stack.pop_back();
+            keys.push_back(node->data);
+            node = node->right;
+        }
+    }
+
 public:
     /**
      * @brief Construct a new BST object
@@ -106,6 +247,111 @@ public:
         root = nullptr;
     }
 
+    /**
+     * @brief Destroy the BST object, freeing every node
+     */
+    ~BST()
+    {
+        clear();
+    }
+
+    BST(const BST &) = delete;
+    BST &operator=(const BST &) = delete;
+
+    /**
+     * @brief Take over the nodes of another tree, leaving it empty
+     */
+    BST(BST &&other) noexcept
+    {
+        root = other.root;
+        other.root = nullptr;
+    }
+
+    /**
+     * @brief Free this tree's nodes and take over those of another tree
+     */
+    BST &operator=(BST &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            root = other.root;
+            other.root = nullptr;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Remove every value, freeing the nodes
+     *
+     * Rotates each left child up until the node has none, then frees the
+     * node and moves right. Needs no stack and no recursion, so trees of any
+     * depth are freed in O(n) time and O(1) extra space.
+     */
+    void clear()
+    {
+        Node *node = root;
+        while (node != nullptr)
+        {
+            if (node->left != nullptr)
+            {
+                Node *left = node->left;
+                node->left = left->right;
+                left->right = node;
+                node = left;
+            }
+            else
+            {
+                Node *right = node->right;
+                delete node;
+                node = right;
+            }
+        }
+        root = nullptr;
+    }
+
+    /**
+     * @brief Remove a value from the BST and free its node
+     * @param value The value to be removed
+     * @return true if the value was removed, false if it was not present
+     *
+     * A node with two children takes the value of its in-order successor,
+     * the leftmost node of its right subtree, and the successor is unlinked
+     * instead.
+     */
+    bool erase(int value)
+    {
+        Node **link = &root;
+        while (*link != nullptr && (*link)->data != value)
+        {
+            link = value < (*link)->data ? &(*link)->left : &(*link)->right;
+        }
+        if (*link == nullptr)
+        {
+            return false;
+        }
+
+        Node *node = *link;
+        if (node->left != nullptr && node->right != nullptr)
+        {
+            Node **successorLink = &node->right;
+            while ((*successorLink)->left != nullptr)
+            {
+                successorLink = &(*successorLink)->left;
+            }
+            Node *successor = *successorLink;
+            node->data = successor->data;
+            *successorLink = successor->right;
+            delete successor;
+        }
+        else
+        {
+            *link = node->left != nullptr ? node->left : node->right;
+            delete node;
+        }
+        return true;
+    }
+
     /**
      * @brief Insert a new value into the BST
      * @param value The value to be inserted
@@ -124,14 +370,95 @@ public:
     {
         return search(root, value);
     }
+
+    /**
+     * @brief Copy the keys into a read-only EytzingerTree
+     *
+     * The BST is left unchanged; later inserts are not seen by the copy.
+     */
+    EytzingerTree freeze()
+    {
+        vector<int> keys;
+        collect(root, keys);
+        return EytzingerTree(keys.data(), (int)keys.size());
+    }
 };
 
+/**
+ * @brief Times lookups of the given keys in a tree
+ * @param tree The tree
+ * @param queries The keys to look up
+ * @param found Set to the number of keys found
+ * @return The average time per lookup in nanoseconds
+ */
+template <typename Tree>
+double timeLookups(Tree &tree, const vector<int> &queries, long long &found)
+{
+    found = 0;
+    auto start = chrono::steady_clock::now();
+    for (int key : queries)
+    {
+        found += tree.search(key);
+    }
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(end - start).count() / (double)queries.size();
+}
+
+/**
+ * @brief Compares point lookups in the BST and its frozen EytzingerTree
+ * @param n The number of random keys inserted into the BST
+ * @return 0 if both found the same keys, 1 otherwise
+ */
+int runBenchmark(int n)
+{
+    mt19937 generator(13);
+    vector<int> keys(n);
+    for (int &key : keys)
+    {
+        key = (int)(generator() >> 1); // Non-negative, so the negative queries below miss
+    }
+
+    // Half the queries hit inserted keys, half miss
+    vector<int> queries(n);
+    for (int i = 0; i < n; i++)
+    {
+        queries[i] = i % 2 == 0 ? keys[generator() % n] : (int)(generator() | 0x80000000u);
+    }
+
+    BST tree;
+    for (int key : keys)
+    {
+        tree.insert(key);
+    }
+    EytzingerTree frozen = tree.freeze();
+    cout << "Froze " << frozen.count() << " distinct keys into " << frozen.memoryBytes() / (1024 * 1024)
+         << " MB (the BST nodes take " << (long long)sizeof(Node) * frozen.count() / (1024 * 1024) << " MB)"
+         << endl;
+
+    long long bstFound, frozenFound;
+    double bstNs = timeLookups(tree, queries, bstFound);
+    double frozenNs = timeLookups(frozen, queries, frozenFound);
+    cout << "BST lookups:       " << bstNs << " ns/lookup" << endl;
+    cout << "Eytzinger lookups: " << frozenNs << " ns/lookup (" << bstNs / frozenNs << "x faster)" << endl;
+
+    bool agree = bstFound == frozenFound;
+    cout << "Lookup results " << (agree ? "agree" : "DISAGREE") << " (" << frozenFound << " found)" << endl;
+    return agree ? 0 : 1;
+}
+
 /**
  * @brief Main function to demonstrate searching in the binary search tree
+ * @param argc Number of command-line arguments
+ * @param argv Pass --benchmark [n] to compare lookups with the frozen tree instead
  * @return int Returns 0 upon successful execution
  */
-int main()
+int main(int argc, char *argv[])
 {
+    if (argc > 1 && string(argv[1]) == "--benchmark")
+    {
+        return runBenchmark(argc > 2 ? atoi(argv[2]) : 10000000);
+    }
+
     // Create a new BST object
     BST tree;
 
@@ -166,5 +493,27 @@ int main()
         cout << valueToSearch << " not found in the BST." << endl;
     }
 
+    // Demonstrate erase functionality
+    tree.erase(40);
+    cout << "40 " << (tree.search(40) ? "found" : "not found") << " in the BST after erasing it." << endl;
+
+    // Freeze the tree for read-only lookups
+    EytzingerTree frozen = tree.freeze();
+    valueToSearch = 60;
+    cout << valueToSearch << (frozen.search(valueToSearch) ? " found" : " not found") << " in the frozen tree."
+         << endl;
+
     return 0;
 }
+
+/**
+ * Usage Instructions:
+ * 1. Compile the program with C++17 (e.g., g++ -std=c++17 -O2 bst_search_algorithm.cpp -o bst_search_algorithm)
+ * 2. Run the compiled executable (e.g., ./bst_search_algorithm)
+ * 3. The program will display the results of searching the BST and its frozen copy
+ *
+ * To compare point lookups with the frozen tree, run ./bst_search_algorithm --benchmark [n]
+ *
+ * A sorted array from any of the sort routines can be frozen directly with
+ * EytzingerTree(arr, n), provided it holds no duplicates.
+ */
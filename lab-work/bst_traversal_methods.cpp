@@ -5,9 +5,16 @@
  * This file contains the implementation of a Binary Search Tree data structure
  * along with its traversal methods (in-order, pre-order, and post-order).
  * It demonstrates the creation, insertion, and traversal of a BST.
+ *
+ * The traversals are iterative, so a degenerate tree (keys inserted in
+ * sorted order) does not overflow the call stack, and they pass each value
+ * to a caller-supplied visitor instead of printing it. The visitor returns
+ * false to stop the traversal early. The Morris variants use O(1) extra
+ * space by temporarily threading the tree through its empty right pointers.
  */
 
 #include <iostream>
+#include <vector>
 using namespace std;
 
 /**
@@ -45,63 +52,122 @@ class BST
 private:
     Node *root; ///< Pointer to the root node of the BST
 
+    vector<Node *> stack; ///< Reused by the iterative traversals, so repeated calls do not allocate
+
+public:
     /**
-     * @brief Perform an in-order traversal of the BST
-     * @param node Pointer to the current node being visited
+     * @brief Construct a new BST object
      *
-     * Traversal order: Left -> Root -> Right
+     * Initializes an empty BST with a null root.
      */
-    void inOrder(Node *node)
+    BST()
     {
-        if (node != nullptr)
-        {
-            inOrder(node->left);
-            cout << node->data << " ";
-            inOrder(node->right);
-        }
+        root = nullptr;
     }
 
     /**
-     * @brief Perform a pre-order traversal of the BST
-     * @param node Pointer to the current node being visited
-     *
-     * Traversal order: Root -> Left -> Right
+     * @brief Destroy the BST object, freeing every node
      */
-    void preOrder(Node *node)
+    ~BST()
     {
-        if (node != nullptr)
+        clear();
+    }
+
+    BST(const BST &) = delete;
+    BST &operator=(const BST &) = delete;
+
+    /**
+     * @brief Take over the nodes of another tree, leaving it empty
+     */
+    BST(BST &&other) noexcept
+    {
+        root = other.root;
+        other.root = nullptr;
+    }
+
+    /**
+     * @brief Free this tree's nodes and take over those of another tree
+     */
+    BST &operator=(BST &&other) noexcept
+    {
+        if (this != &other)
         {
-            cout << node->data << " ";
-            preOrder(node->left);
-            preOrder(node->right);
+            clear();
+            root = other.root;
+            other.root = nullptr;
         }
+        return *this;
     }
 
     /**
-     * @brief Perform a post-order traversal of the BST
-     * @param node Pointer to the current node being visited
+     * @brief Remove every value, freeing the nodes
      *
-     * Traversal order: Left -> Right -> Root
+     * Rotates each left child up until the node has none, then frees the
+     * node and moves right. Needs no stack and no recursion, so trees of any
+     * depth are freed in O(n) time and O(1) extra space.
      */
-    void postOrder(Node *node)
+    void clear()
     {
-        if (node != nullptr)
+        Node *node = root;
+        while (node != nullptr)
         {
-            postOrder(node->left);
-            postOrder(node->right);
-            cout << node->data << " ";
+            if (node->left != nullptr)
+            {
+                Node *left = node->left;
+                node->left = left->right;
+                left->right = node;
+                node = left;
+            }
+            else
+            {
+                Node *right = node->right;
+                delete node;
+                node = right;
+            }
         }
+        root = nullptr;
     }
 
-public:
     /**
-     * @brief Construct a new BST object
+     * @brief Remove a value from the BST and free its node
+     * @param value The value to be removed
+     * @return true if the value was removed, false if it was not present
      *
-     * Initializes an empty BST with a null root.
+     * A node with two children takes the value of its in-order successor,
+     * the leftmost node of its right subtree, and the successor is unlinked
+     * instead.
      */
-    BST()
+    bool erase(int value)
     {
-        root = nullptr;
+        Node **link = &root;
+        while (*link != nullptr && (*link)->data != value)
+        {
+            link = value < (*link)->data ? &(*link)->left : &(*link)->right;
+        }
+        if (*link == nullptr)
+        {
+            return false;
+        }
+
+        Node *node = *link;
+        if (node->left != nullptr && node->right != nullptr)
+        {
+            Node **successorLink = &node->right;
+            while ((*successorLink)->left != nullptr)
+            {
+                successorLink = &(*successorLink)->left;
+            }
+            Node *successor = *successorLink;
+            node->data = successor->data;
+            *successorLink = successor->right;
+            delete successor;
+        }
+        else
+        {
+            *link = node->left != nullptr ? node->left : node->right;
+            delete node;
+        }
+        return true;
     }
 
     /**
@@ -117,13 +183,17 @@ public:
             return new Node(value);
         }
 
-        if (value < node->data)
-        {
-            node->left = insert(node->left, value);
-        }
-        else if (value > node->data)
+        // Walk down iteratively, so deep trees do not overflow the call stack
+        Node *current = node;
+        while (value != current->data)
         {
-            node->right = insert(node->right, value);
+            Node *&child = value < current->data ? current->left : current->right;
+            if (child == nullptr)
+            {
+                child = new Node(value);
+                break;
+            }
+            current = child;
         }
         return node;
     }
@@ -137,6 +207,202 @@ public:
         root = insert(root, value);
     }
 
+    /**
+     * @brief Visit every value in ascending order (Left -> Root -> Right)
+     * @param visit Called with each value; returns false to stop the traversal
+     * @return true if every value was visited, false if visit stopped it
+     */
+    template <typename Visitor>
+    bool visitInOrder(Visitor visit)
+    {
+        stack.clear();
+        Node *node = root;
+        while (node != nullptr || !stack.empty())
+        {
+            // Descend left, remembering the nodes still to be visited
+            while (node != nullptr)
+            {
+                stack.push_back(node);
+                node = node->left;
+            }
+            node = stack.back();
+            stack.pop_back();
+            if (!visit(node->data))
+            {
+                return false;
+            }
+            node = node->right;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Visit every value in pre-order (Root -> Left -> Right)
+     * @param visit Called with each value; returns false to stop the traversal
+     * @return true if every value was visited, false if visit stopped it
+     */
+    template <typename Visitor>
+    bool visitPreOrder(Visitor visit)
+    {
+        stack.clear();
+        if (root != nullptr)
+        {
+            stack.push_back(root);
+        }
+        while (!stack.empty())
+        {
+            Node *node = stack.back();
+            stack.pop_back();
+            if (!visit(node->data))
+            {
+                return false;
+            }
+
+            // Push right first so the left subtree is visited first
+            if (node->right != nullptr)
+            {
+                stack.push_back(node->right);
+            }
+            if (node->left != nullptr)
+            {
+                stack.push_back(node->left);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Visit every value in post-order (Left -> Right -> Root)
+     * @param visit Called with each value; returns false to stop the traversal
+     * @return true if every value was visited, false if visit stopped it
+     */
+    template <typename Visitor>
+    bool visitPostOrder(Visitor visit)
+    {
+        stack.clear();
+        Node *node = root;
+        Node *lastVisited = nullptr;
+        while (node != nullptr || !stack.empty())
+        {
+            while (node != nullptr)
+            {
+                stack.push_back(node);
+                node = node->left;
+            }
+
+            // Visit the top node once its right subtree is done
+            Node *top = stack.back();
+            if (top->right != nullptr && top->right != lastVisited)
+            {
+                node = top->right;
+                continue;
+            }
+            stack.pop_back();
+            if (!visit(top->data))
+            {
+                return false;
+            }
+            lastVisited = top;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Visit every value in ascending order using O(1) extra space
+     * @param visit Called with each value; returns false to stop the traversal
+     * @return true if every value was visited, false if visit stopped it
+     *
+     * Before descending into a left subtree, the rightmost node of that
+     * subtree gets a temporary right pointer back to the current node; the
+     * walk follows it back up and removes it. If visit stops the traversal,
+     * the walk still continues, without visiting, until every temporary
+     * pointer is removed. The tree must not be used by anything else
+     * meanwhile.
+     */
+    template <typename Visitor>
+    bool morrisInOrder(Visitor visit)
+    {
+        bool visiting = true;
+        int threads = 0;
+        Node *node = root;
+        while (node != nullptr && (visiting || threads > 0))
+        {
+            if (node->left == nullptr)
+            {
+                visiting = visiting && visit(node->data);
+                node = node->right;
+                continue;
+            }
+
+            Node *predecessor = node->left;
+            while (predecessor->right != nullptr && predecessor->right != node)
+            {
+                predecessor = predecessor->right;
+            }
+            if (predecessor->right == nullptr)
+            {
+                // First arrival: thread the predecessor back here, then go left
+                predecessor->right = node;
+                threads++;
+                node = node->left;
+            }
+            else
+            {
+                // Back from the left subtree: remove the thread and visit
+                predecessor->right = nullptr;
+                threads--;
+                visiting = visiting && visit(node->data);
+                node = node->right;
+            }
+        }
+        return visiting;
+    }
+
+    /**
+     * @brief Visit every value in pre-order using O(1) extra space
+     * @param visit Called with each value; returns false to stop the traversal
+     * @return true if every value was visited, false if visit stopped it
+     *
+     * Threads the tree as morrisInOrder does, visiting each node on its
+     * first arrival instead.
+     */
+    template <typename Visitor>
+    bool morrisPreOrder(Visitor visit)
+    {
+        bool visiting = true;
+        int threads = 0;
+        Node *node = root;
+        while (node != nullptr && (visiting || threads > 0))
+        {
+            if (node->left == nullptr)
+            {
+                visiting = visiting && visit(node->data);
+                node = node->right;
+                continue;
+            }
+
+            Node *predecessor = node->left;
+            while (predecessor->right != nullptr && predecessor->right != node)
+            {
+                predecessor = predecessor->right;
+            }
+            if (predecessor->right == nullptr)
+            {
+                visiting = visiting && visit(node->data);
+                predecessor->right = node;
+                threads++;
+                node = node->left;
+            }
+            else
+            {
+                predecessor->right = nullptr;
+                threads--;
+                node = node->right;
+            }
+        }
+        return visiting;
+    }
+
     /**
      * @brief Public method to perform an in-order traversal of the BST
      *
@@ -144,7 +410,10 @@ public:
      */
     void inOrder()
     {
-        inOrder(root);
+        visitInOrder([](int value) {
+            cout << value << " ";
+            return true;
+        });
         cout << endl;
     }
 
@@ -155,7 +424,10 @@ public:
      */
     void preOrder()
     {
-        preOrder(root);
+        visitPreOrder([](int value) {
+            cout << value << " ";
+            return true;
+        });
         cout << endl;
     }
 
@@ -166,7 +438,10 @@ public:
      */
     void postOrder()
     {
-        postOrder(root);
+        visitPostOrder([](int value) {
+            cout << value << " ";
+            return true;
+        });
         cout << endl;
     }
 };
@@ -198,5 +473,50 @@ int main()
     cout << "Post-order traversal: ";
     tree.postOrder();
 
+    // Demonstrate erase functionality
+    tree.erase(50);
+    cout << "In-order traversal after erasing the root 50: ";
+    tree.inOrder();
+
+    // Consume the values without printing, stopping after the first three
+    int seen = 0;
+    cout << "Three smallest values (Morris in-order): ";
+    tree.morrisInOrder([&seen](int value) {
+        cout << value << " ";
+        return ++seen < 3;
+    });
+    cout << endl;
+
+    // Sorted inserts give a tree as deep as it is large; no traversal recurses
+    BST deepTree;
+    const int deepSize = 20000;
+    for (int i = 1; i <= deepSize; i++)
+    {
+        deepTree.insert(i);
+    }
+    long long sum = 0;
+    deepTree.visitPostOrder([&sum](int value) {
+        sum += value;
+        return true;
+    });
+    cout << "Sum of a " << deepSize << "-level tree (post-order): " << sum << endl;
+
+    // Hand the deep tree to a new owner; it is freed without recursion on return
+    BST owner = move(deepTree);
+    cout << "Traversal of the moved tree: " << (owner.visitInOrder([](int) { return true; }) ? "complete" : "stopped")
+         << endl;
+
     return 0;
 }
+
+/**
+ * Usage Instructions:
+ * 1. Compile the program using a C++ compiler (e.g., g++ -O2 bst_traversal_methods.cpp -o bst_traversal_methods)
+ * 2. Run the compiled executable (e.g., ./bst_traversal_methods)
+ * 3. The program will display the three traversals, a traversal after an erase,
+ *    an early-stopped traversal and the sum of the keys of a degenerate tree
+ *
+ * To consume the values in your own code, pass a lambda returning true to
+ * continue or false to stop to visitInOrder, visitPreOrder, visitPostOrder,
+ * morrisInOrder or morrisPreOrder.
+ */
@@ -0,0 +1,872 @@
+/**
+ * @file concurrent_bst.cpp
+ * @brief Implementation of a Binary Search Tree safe for concurrent readers and writers
+ *
+ * The BST in binary_search_tree.cpp has no synchronization, so sharing it
+ * between threads means one global mutex around every call, and lookups
+ * from many threads queue up behind each other and behind the writer.
+ *
+ * ConcurrentBST keeps the same insert/search/inOrder interface for a tree
+ * that only grows:
+ * - A node's key never changes and a child link, once set, is never changed
+ *   again, so a reader can walk the tree with plain acquire loads and no
+ *   lock or retry. search is wait-free: it finishes within one step per
+ *   level whatever the other threads do.
+ * - insert links its new node with one compare-and-swap on the empty child
+ *   pointer it found. The only contention is between writers that reach
+ *   the same empty slot at the same moment; the loser continues its descent
+ *   from the winner's node. No node is ever unlinked, so readers never see
+ *   freed memory and no reclamation scheme is needed until the tree is
+ *   destroyed.
+ *
+ * ConcurrentBST never rebalances, so it is only O(log n) deep when keys
+ * arrive in random order. Sorted or nearly sorted keys build a chain and
+ * every insert and search walks all of it. ConcurrentSkipList keeps the
+ * same CAS publishing and lock-free reads but chooses each node's height at
+ * random, so its expected depth is O(log n) whatever order the keys arrive
+ * in; use it unless the keys are known to be random.
+ *
+ * Running the program with --stress checks both structures under concurrent
+ * writers and readers; --benchmark compares lookup throughput with a
+ * mutex-guarded BST while a writer inserts, and times ascending inserts.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/**
+ * @struct ConcurrentNode
+ * @brief A node of the ConcurrentBST
+ *
+ * The child pointers are atomic so a reader can follow a link while a
+ * writer sets it.
+ */
+struct ConcurrentNode
+{
+    const int data;                 ///< The value stored in the node; never changes
+    atomic<ConcurrentNode *> left;  ///< Pointer to the left child node; set at most once
+    atomic<ConcurrentNode *> right; ///< Pointer to the right child node; set at most once
+
+    /**
+     * @brief Construct a new node with no children
+     * @param value The integer value to be stored in the node
+     */
+    ConcurrentNode(int value) : data(value), left(nullptr), right(nullptr) {}
+};
+
+/**
+ * @class ConcurrentBST
+ * @brief A grow-only Binary Search Tree with wait-free search and lock-free insert
+ *
+ * search and insert may be called from any number of threads at once.
+ * inOrder and count walk the whole tree and see a mix of old and new keys
+ * if writers are running.
+ *
+ * @warning The tree is never rebalanced. Insert keys in random order, or
+ *          use ConcurrentSkipList: n ascending keys make a chain n deep and
+ *          cost O(n^2) to insert.
+ */
+class ConcurrentBST
+{
+private:
+    atomic<ConcurrentNode *> root; ///< Pointer to the root node of the tree
+
+public:
+    /**
+     * @brief Construct an empty tree
+     */
+    ConcurrentBST() : root(nullptr) {}
+
+    /**
+     * @brief Destroy the tree, freeing every node
+     *
+     * No other thread may be using the tree. Uses an explicit stack, so deep
+     * trees do not overflow the call stack.
+     */
+    ~ConcurrentBST()
+    {
+        vector<ConcurrentNode *> stack;
+        ConcurrentNode *top = root.load(memory_order_relaxed);
+        if (top != nullptr)
+        {
+            stack.push_back(top);
+        }
+        while (!stack.empty())
+        {
+            ConcurrentNode *node = stack.back();
+            stack.pop_back();
+            if (ConcurrentNode *left = node->left.load(memory_order_relaxed))
+            {
+                stack.push_back(left);
+            }
+            if (ConcurrentNode *right = node->right.load(memory_order_relaxed))
+            {
+                stack.push_back(right);
+            }
+            delete node;
+        }
+    }
+
+    ConcurrentBST(const ConcurrentBST &) = delete;
+    ConcurrentBST &operator=(const ConcurrentBST &) = delete;
+
+    /**
+     * @brief Insert a new value into the tree; duplicates are ignored
+     * @param value The value to be inserted
+     * @return true if the value was inserted, false if it was already present
+     */
+    bool insert(int value)
+    {
+        ConcurrentNode *newNode = new ConcurrentNode(value);
+        atomic<ConcurrentNode *> *link = &root;
+        while (true)
+        {
+            ConcurrentNode *node = link->load(memory_order_acquire);
+            if (node == nullptr)
+            {
+                // Publish the node; release makes its fields visible to readers
+                // that load the link. On failure node holds the winner's node.
+                if (link->compare_exchange_strong(node, newNode, memory_order_release, memory_order_acquire))
+                {
+                    return true;
+                }
+            }
+            if (value == node->data)
+            {
+                delete newNode;
+                return false;
+            }
+            link = value < node->data ? &node->left : &node->right;
+        }
+    }
+
+    /**
+     * @brief Search for a value in the tree
+     * @param value The value to search for
+     * @return true if the value is found, false otherwise
+     *
+     * Finds every value whose insert returned before the search started.
+     */
+    bool search(int value) const
+    {
+        ConcurrentNode *node = root.load(memory_order_acquire);
+        while (node != nullptr)
+        {
+            if (value == node->data)
+            {
+                return true;
+            }
+            node = (value < node->data ? node->left : node->right).load(memory_order_acquire);
+        }
+        return false;
+    }
+
+    /**
+     * @brief Calls visit(key) for every key in ascending order
+     * @param visit The function to call with each key
+     */
+    template <typename Visitor>
+    void forEach(Visitor visit) const
+    {
+        vector<ConcurrentNode *> stack;
+        ConcurrentNode *node = root.load(memory_order_acquire);
+        while (node != nullptr || !stack.empty())
+        {
+            while (node != nullptr)
+            {
+                stack.push_back(node);
+                node = node->left.load(memory_order_acquire);
+            }
+            node = stack.back();
+            stack.pop_back();
+            visit(node->data);
+            node = node->right.load(memory_order_acquire);
+        }
+    }
+
+    /**
+     * @brief Perform an in-order traversal of the tree
+     *
+     * Prints the values of the tree in ascending order
+     */
+    void inOrder() const
+    {
+        forEach([](int key) { cout << key << " "; });
+        cout << endl;
+    }
+
+    /**
+     * @brief Returns the number of keys stored
+     */
+    long long count() const
+    {
+        long long keys = 0;
+        forEach([&keys](int) { keys++; });
+        return keys;
+    }
+};
+
+/**
+ * @struct SkipNode
+ * @brief A node of the ConcurrentSkipList: one key and height forward links
+ *
+ * The links are stored right after the node in the same allocation, so a
+ * node costs one allocation and the links share its cache line.
+ */
+struct SkipNode
+{
+    const int data;   ///< The value stored in the node; never changes
+    const int height; ///< The number of levels the node is linked into
+
+    /**
+     * @brief Returns the node's forward links; next()[level] is set at most once after linking
+     */
+    atomic<SkipNode *> *next()
+    {
+        return reinterpret_cast<atomic<SkipNode *> *>(this + 1);
+    }
+
+    /**
+     * @brief Allocates a node holding value with height null links
+     */
+    static SkipNode *create(int value, int height)
+    {
+        void *memory = ::operator new(sizeof(SkipNode) + height * sizeof(atomic<SkipNode *>));
+        SkipNode *node = new (memory) SkipNode{value, height};
+        for (int level = 0; level < height; level++)
+        {
+            new (&node->next()[level]) atomic<SkipNode *>(nullptr);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Frees a node made by create
+     */
+    static void destroy(SkipNode *node)
+    {
+        node->~SkipNode();
+        ::operator delete(node);
+    }
+};
+
+static_assert(sizeof(SkipNode) % alignof(atomic<SkipNode *>) == 0, "links must follow SkipNode aligned");
+
+/**
+ * @class ConcurrentSkipList
+ * @brief A grow-only skip list with lock-free search and insert, balanced for any key order
+ *
+ * Level 0 links every key in ascending order; each higher level links a
+ * random half of the level below, so a search skips ahead on the high levels
+ * and drops down, taking O(log n) expected steps. Heights depend only on a
+ * random number generator, never on the keys, so sorted input is as fast as
+ * random input.
+ *
+ * insert publishes the node on level 0 with one compare-and-swap; from then
+ * on search finds it. The higher levels are linked afterwards, bottom up,
+ * each with its own compare-and-swap, and only make searches faster. A
+ * node's links are set before it is published on their level and never
+ * change again, and no node is unlinked before the list is destroyed, so
+ * search uses plain acquire loads and never waits or retries.
+ */
+class ConcurrentSkipList
+{
+private:
+    static const int MAX_LEVEL = 24; ///< Enough levels for 2^24 keys at O(log n) depth
+
+    atomic<SkipNode *> head[MAX_LEVEL]; ///< The first node on each level
+    atomic<int> levels;                 ///< Height of the tallest node; search starts there
+
+    /**
+     * @brief Draws a height: 1 with probability 1/2, 2 with 1/4, and so on
+     */
+    static int randomHeight()
+    {
+        thread_local mt19937 generator((unsigned)hash<thread::id>()(this_thread::get_id()));
+        unsigned bits = generator();
+        int height = 1;
+        while (height < MAX_LEVEL && (bits & 1) != 0)
+        {
+            height++;
+            bits >>= 1;
+        }
+        return height;
+    }
+
+    /**
+     * @brief Finds where value belongs on every level
+     * @param value The value to look for
+     * @param preds Set to the link on each level that precedes value
+     * @param succs Set to the node each of those links points at
+     * @return The node holding value, or nullptr if it is not on level 0
+     */
+    SkipNode *find(int value, atomic<SkipNode *> **preds, SkipNode **succs)
+    {
+        atomic<SkipNode *> *links = head;
+        for (int level = MAX_LEVEL - 1; level >= 0; level--)
+        {
+            SkipNode *node = links[level].load(memory_order_acquire);
+            while (node != nullptr && node->data < value)
+            {
+                links = node->next();
+                node = links[level].load(memory_order_acquire);
+            }
+            preds[level] = &links[level];
+            succs[level] = node;
+        }
+        return succs[0] != nullptr && succs[0]->data == value ? succs[0] : nullptr;
+    }
+
+public:
+    /**
+     * @brief Construct an empty list
+     */
+    ConcurrentSkipList() : levels(1)
+    {
+        for (atomic<SkipNode *> &link : head)
+        {
+            link.store(nullptr, memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Destroy the list, freeing every node
+     *
+     * No other thread may be using the list.
+     */
+    ~ConcurrentSkipList()
+    {
+        SkipNode *node = head[0].load(memory_order_relaxed);
+        while (node != nullptr)
+        {
+            SkipNode *next = node->next()[0].load(memory_order_relaxed);
+            SkipNode::destroy(node);
+            node = next;
+        }
+    }
+
+    ConcurrentSkipList(const ConcurrentSkipList &) = delete;
+    ConcurrentSkipList &operator=(const ConcurrentSkipList &) = delete;
+
+    /**
+     * @brief Insert a new value into the list; duplicates are ignored
+     * @param value The value to be inserted
+     * @return true if the value was inserted, false if it was already present
+     */
+    bool insert(int value)
+    {
+        atomic<SkipNode *> *preds[MAX_LEVEL];
+        SkipNode *succs[MAX_LEVEL];
+        if (find(value, preds, succs) != nullptr)
+        {
+            return false;
+        }
+
+        int height = randomHeight();
+        SkipNode *newNode = SkipNode::create(value, height);
+        while (true)
+        {
+            for (int level = 0; level < height; level++)
+            {
+                newNode->next()[level].store(succs[level], memory_order_relaxed);
+            }
+            // Publish on level 0; release makes the key and links visible to
+            // readers that load the link. On failure a writer got there
+            // first, so look again, and give up if it inserted value.
+            SkipNode *expected = succs[0];
+            if (preds[0]->compare_exchange_strong(expected, newNode, memory_order_release, memory_order_relaxed))
+            {
+                break;
+            }
+            if (find(value, preds, succs) != nullptr)
+            {
+                SkipNode::destroy(newNode);
+                return false;
+            }
+        }
+
+        // Link the higher levels. Readers only reach newNode->next()[level]
+        // through a link on that level or above, so it may still be updated
+        // until the compare-and-swap publishes it.
+        for (int level = 1; level < height; level++)
+        {
+            while (true)
+            {
+                SkipNode *expected = succs[level];
+                if (preds[level]->compare_exchange_strong(expected, newNode, memory_order_release,
+                                                          memory_order_relaxed))
+                {
+                    break;
+                }
+                find(value, preds, succs);
+                newNode->next()[level].store(succs[level], memory_order_relaxed);
+            }
+        }
+
+        int top = levels.load(memory_order_relaxed);
+        while (top < height && !levels.compare_exchange_weak(top, height, memory_order_relaxed))
+        {
+        }
+        return true;
+    }
+
+    /**
+     * @brief Search for a value in the list
+     * @param value The value to search for
+     * @return true if the value is found, false otherwise
+     *
+     * Finds every value whose insert returned before the search started.
+     * Starting below the tallest node is still correct, only slower, so
+     * levels needs no ordering.
+     */
+    bool search(int value) const
+    {
+        const atomic<SkipNode *> *links = head;
+        SkipNode *node = nullptr;
+        for (int level = levels.load(memory_order_relaxed) - 1; level >= 0; level--)
+        {
+            node = links[level].load(memory_order_acquire);
+            while (node != nullptr && node->data < value)
+            {
+                links = node->next();
+                node = links[level].load(memory_order_acquire);
+            }
+        }
+        return node != nullptr && node->data == value;
+    }
+
+    /**
+     * @brief Calls visit(key) for every key in ascending order
+     * @param visit The function to call with each key
+     */
+    template <typename Visitor>
+    void forEach(Visitor visit) const
+    {
+        for (SkipNode *node = head[0].load(memory_order_acquire); node != nullptr;
+             node = node->next()[0].load(memory_order_acquire))
+        {
+            visit(node->data);
+        }
+    }
+
+    /**
+     * @brief Perform an in-order traversal of the list
+     *
+     * Prints the values of the list in ascending order
+     */
+    void inOrder() const
+    {
+        forEach([](int key) { cout << key << " "; });
+        cout << endl;
+    }
+
+    /**
+     * @brief Returns the number of keys stored
+     */
+    long long count() const
+    {
+        long long keys = 0;
+        forEach([&keys](int) { keys++; });
+        return keys;
+    }
+};
+
+/**
+ * @class MutexBST
+ * @brief The BST of binary_search_tree.cpp behind one mutex, the approach ConcurrentBST replaces
+ */
+class MutexBST
+{
+private:
+    /**
+     * @struct Node
+     * @brief A BST node: one key and two child pointers
+     */
+    struct Node
+    {
+        int data;    ///< The value stored in the node
+        Node *left;  ///< Pointer to the left child node
+        Node *right; ///< Pointer to the right child node
+
+        /// Construct a leaf node holding value
+        Node(int value) : data(value), left(nullptr), right(nullptr) {}
+    };
+
+    Node *root;          ///< Pointer to the root node of the tree
+    mutable mutex guard; ///< Serializes every insert and search
+
+    /**
+     * @brief Deletes a subtree; random keys keep the recursion shallow
+     */
+    void destroy(Node *node)
+    {
+        if (node != nullptr)
+        {
+            destroy(node->left);
+            destroy(node->right);
+            delete node;
+        }
+    }
+
+public:
+    /// Construct an empty tree
+    MutexBST() : root(nullptr) {}
+
+    /// Destroy the tree, freeing every node
+    ~MutexBST() { destroy(root); }
+
+    MutexBST(const MutexBST &) = delete;
+    MutexBST &operator=(const MutexBST &) = delete;
+
+    /// Insert a new value into the tree, holding the mutex
+    bool insert(int value)
+    {
+        lock_guard<mutex> lock(guard);
+        Node **link = &root;
+        while (*link != nullptr)
+        {
+            if (value == (*link)->data)
+            {
+                return false;
+            }
+            link = value < (*link)->data ? &(*link)->left : &(*link)->right;
+        }
+        *link = new Node(value);
+        return true;
+    }
+
+    /// Search for a value in the tree, holding the mutex
+    bool search(int value) const
+    {
+        lock_guard<mutex> lock(guard);
+        Node *node = root;
+        while (node != nullptr && node->data != value)
+        {
+            node = value < node->data ? node->left : node->right;
+        }
+        return node != nullptr;
+    }
+};
+
+/**
+ * @brief Checks a tree while writers insert and readers search concurrently
+ * @tparam Tree ConcurrentBST or ConcurrentSkipList
+ * @param name The name printed with the result
+ * @param threads The number of writer threads; as many reader threads run alongside
+ * @param keysPerWriter The number of keys each writer inserts
+ * @return 0 if every check passed, 1 otherwise
+ *
+ * Writer w inserts the non-negative keys congruent to w modulo the writer
+ * count, in random order, and publishes how many it has inserted. Readers
+ * check that every published key is found and that negative keys, which are
+ * never inserted, are not.
+ */
+template <typename Tree>
+int runStressTest(const char *name, int threads, int keysPerWriter)
+{
+    Tree tree;
+    vector<vector<int>> writerKeys(threads);
+    for (int w = 0; w < threads; w++)
+    {
+        for (int i = 0; i < keysPerWriter; i++)
+        {
+            writerKeys[w].push_back(i * threads + w);
+        }
+        shuffle(writerKeys[w].begin(), writerKeys[w].end(), mt19937(w));
+    }
+
+    vector<atomic<int>> published(threads);
+    atomic<int> writersRunning(threads);
+    atomic<long long> failures(0);
+    atomic<long long> duplicates(0);
+    vector<thread> workers;
+
+    for (int w = 0; w < threads; w++)
+    {
+        published[w].store(0);
+        workers.emplace_back([&, w]() {
+            for (int i = 0; i < keysPerWriter; i++)
+            {
+                if (!tree.insert(writerKeys[w][i]))
+                {
+                    duplicates++;
+                }
+                published[w].store(i + 1, memory_order_release);
+            }
+            writersRunning--;
+        });
+    }
+    for (int r = 0; r < threads; r++)
+    {
+        workers.emplace_back([&, r]() {
+            mt19937 generator(1000 + r);
+            long long checks = 0;
+            while (writersRunning.load() > 0 || checks < 100000)
+            {
+                int w = (int)(generator() % threads);
+                int done = published[w].load(memory_order_acquire);
+                if (done > 0 && !tree.search(writerKeys[w][generator() % done]))
+                {
+                    failures++;
+                }
+                if (tree.search(-1 - (int)(generator() % 1000000)))
+                {
+                    failures++;
+                }
+                checks++;
+            }
+        });
+    }
+    for (thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    // Quiescent checks: every key present exactly once, in ascending order
+    long long expected = (long long)threads * keysPerWriter;
+    long long seen = 0;
+    int previous = -1;
+    bool ordered = true;
+    tree.forEach([&](int key) {
+        ordered = ordered && key == previous + 1;
+        previous = key;
+        seen++;
+    });
+
+    bool passed = failures == 0 && duplicates == 0 && ordered && seen == expected;
+    cout << name << ", " << threads << " writers and " << threads << " readers, " << expected << " keys: " << failures
+         << " failed lookups, " << duplicates << " duplicate inserts, " << seen << " keys "
+         << (ordered ? "in order" : "OUT OF ORDER") << " - " << (passed ? "PASSED" : "FAILED") << endl;
+    return passed ? 0 : 1;
+}
+
+/**
+ * @brief Measures lookups per second from reader threads while one writer inserts
+ * @param tree The tree, already holding the keys in present
+ * @param readers The number of reader threads
+ * @param present Keys already in the tree, which readers look up
+ * @param fresh Keys the writer inserts while the readers run
+ * @param lookupsPerReader The number of lookups each reader makes
+ * @return Millions of lookups per second over all readers
+ */
+template <typename Tree>
+double measureThroughput(Tree &tree, int readers, const vector<int> &present, const vector<int> &fresh,
+                         int lookupsPerReader)
+{
+    atomic<int> readersRunning(readers);
+    atomic<long long> found(0);
+    thread writer([&]() {
+        for (size_t i = 0; i < fresh.size() && readersRunning.load(memory_order_relaxed) > 0; i++)
+        {
+            tree.insert(fresh[i]);
+        }
+    });
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (int r = 0; r < readers; r++)
+    {
+        workers.emplace_back([&, r]() {
+            mt19937 generator(r);
+            long long hits = 0;
+            for (int i = 0; i < lookupsPerReader; i++)
+            {
+                hits += tree.search(present[generator() % present.size()]);
+            }
+            found += hits;
+            readersRunning--;
+        });
+    }
+    for (thread &worker : workers)
+    {
+        worker.join();
+    }
+    auto end = chrono::steady_clock::now();
+    writer.join();
+
+    if (found != (long long)readers * lookupsPerReader)
+    {
+        cout << "ERROR: a present key was not found" << endl;
+    }
+    double seconds = chrono::duration<double>(end - start).count();
+    return (double)readers * lookupsPerReader / seconds / 1e6;
+}
+
+/**
+ * @brief Fills a fresh Tree with keys and measures its read throughput
+ */
+template <typename Tree>
+double measureFreshTree(int readers, const vector<int> &present, const vector<int> &fresh, int lookupsPerReader)
+{
+    Tree tree;
+    for (int key : present)
+    {
+        tree.insert(key);
+    }
+    return measureThroughput(tree, readers, present, fresh, lookupsPerReader);
+}
+
+/**
+ * @brief Times inserting the keys 0 to n - 1 in ascending order from one thread
+ * @return The time taken in milliseconds
+ */
+template <typename Tree>
+double measureAscendingInserts(int n)
+{
+    Tree tree;
+    auto start = chrono::steady_clock::now();
+    for (int key = 0; key < n; key++)
+    {
+        tree.insert(key);
+    }
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Compares read throughput of the mutex-guarded BST, ConcurrentBST and ConcurrentSkipList
+ * @param n The number of keys in each tree before the readers start
+ * @param maxThreads The largest number of reader threads
+ * @return 0 on success
+ */
+int runBenchmark(int n, int maxThreads)
+{
+    mt19937 generator(18);
+    vector<int> present(n), fresh(n);
+    for (int i = 0; i < n; i++)
+    {
+        present[i] = (int)(generator() >> 1);
+        fresh[i] = (int)(generator() >> 1);
+    }
+
+    vector<int> readerCounts;
+    for (int t = 1; t < maxThreads; t *= 2)
+    {
+        readerCounts.push_back(t);
+    }
+    readerCounts.push_back(maxThreads);
+
+    const int lookupsPerReader = 1000000;
+    cout << "Lookups from R readers while 1 writer inserts, " << n << " keys" << endl;
+    cout << "readers\tmutex M/s\tconcurrent M/s\tskip list M/s\tspeedup" << endl;
+    for (int readers : readerCounts)
+    {
+        // Fresh trees per row, so each writer starts from the same n keys
+        double mutexRate = measureFreshTree<MutexBST>(readers, present, fresh, lookupsPerReader);
+        double concurrentRate = measureFreshTree<ConcurrentBST>(readers, present, fresh, lookupsPerReader);
+        double skipListRate = measureFreshTree<ConcurrentSkipList>(readers, present, fresh, lookupsPerReader);
+
+        // One # per million lookups per second, up to 60
+        int bar = min(60, (int)concurrentRate);
+        cout << readers << "\t" << mutexRate << "\t\t" << concurrentRate << "\t\t" << skipListRate << "\t\t"
+             << concurrentRate / mutexRate << "x\t" << string(bar, '#') << endl;
+    }
+
+    // Sorted keys turn the unbalanced tree into a chain; keep n small enough
+    // for its O(n^2) inserts to finish
+    int ascending = min(n, 10000);
+    cout << endl << "Inserting " << ascending << " ascending keys" << endl;
+    cout << "ConcurrentBST: " << measureAscendingInserts<ConcurrentBST>(ascending) << " ms" << endl;
+    cout << "ConcurrentSkipList: " << measureAscendingInserts<ConcurrentSkipList>(ascending) << " ms" << endl;
+    return 0;
+}
+
+/**
+ * @brief Main function to demonstrate the concurrent Binary Search Tree
+ * @param argc Number of command-line arguments
+ * @param argv Pass --stress [threads] to run the stress tests, or
+ *             --benchmark [n] [maxThreads] to compare with a mutex-guarded BST, instead
+ * @return int Exit status of the program
+ */
+int main(int argc, char *argv[])
+{
+    int hardwareThreads = max(1, (int)thread::hardware_concurrency());
+    if (argc > 1 && string(argv[1]) == "--stress")
+    {
+        int threads = argc > 2 ? max(1, atoi(argv[2])) : hardwareThreads;
+        return runStressTest<ConcurrentBST>("ConcurrentBST", threads, 200000) |
+               runStressTest<ConcurrentSkipList>("ConcurrentSkipList", threads, 200000);
+    }
+    if (argc > 1 && string(argv[1]) == "--benchmark")
+    {
+        int n = argc > 2 ? atoi(argv[2]) : 1000000;
+        return runBenchmark(n, argc > 3 ? max(1, atoi(argv[3])) : hardwareThreads);
+    }
+
+    // Create a new tree and fill it from four threads at once
+    ConcurrentBST tree;
+    int values[] = {50, 30, 20, 40, 70, 60, 80, 35};
+    vector<thread> writers;
+    for (int t = 0; t < 4; t++)
+    {
+        writers.emplace_back([&tree, &values, t]() {
+            tree.insert(values[2 * t]);
+            tree.insert(values[2 * t + 1]);
+        });
+    }
+    for (thread &writer : writers)
+    {
+        writer.join();
+    }
+
+    // Perform in-order traversal
+    cout << "In-order traversal of the concurrent BST: ";
+    tree.inOrder();
+
+    // Demonstrate search functionality
+    int valueToSearch = 40;
+    if (tree.search(valueToSearch))
+    {
+        cout << valueToSearch << " found in the concurrent BST." << endl;
+    }
+    else
+    {
+        cout << valueToSearch << " not found in the concurrent BST." << endl;
+    }
+
+    // Sorted keys would make the tree a chain; the skip list stays shallow
+    ConcurrentSkipList list;
+    vector<thread> sortedWriters;
+    for (int t = 0; t < 4; t++)
+    {
+        sortedWriters.emplace_back([&list, t]() {
+            for (int key = t * 5; key < t * 5 + 5; key++)
+            {
+                list.insert(key);
+            }
+        });
+    }
+    for (thread &writer : sortedWriters)
+    {
+        writer.join();
+    }
+    cout << "In-order traversal of the skip list filled with ascending keys: ";
+    list.inOrder();
+
+    return 0;
+}
+
+/**
+ * Usage Instructions:
+ * 1. Compile the program with thread support (e.g., g++ -O2 -pthread concurrent_bst.cpp -o concurrent_bst)
+ * 2. Run the compiled executable (e.g., ./concurrent_bst)
+ * 3. The program will display the keys inserted by four threads, a search result, and a skip list
+ *    filled with ascending keys
+ *
+ * To stress-test both structures, run ./concurrent_bst --stress [threads]
+ * To compare read throughput with a mutex-guarded BST, run ./concurrent_bst --benchmark [n] [maxThreads]
+ *
+ * To use the tree in your own code:
+ * 1. Include the SkipNode struct and ConcurrentSkipList class in your program, or ConcurrentNode and
+ *    ConcurrentBST if the keys arrive in random order
+ * 2. Share one instance between threads and call insert and search from any of them
+ */
@@ -5,8 +5,14 @@
  * This program demonstrates the implementation of a doubly linked list data structure
  * with operations to insert nodes at the beginning and end of the list, display the list,
  * and a menu-driven interface for user interaction.
+ *
+ * Nodes come from a NodePool (node_pool.h) rather than one new per node.
+ * The list keeps pointers to both ends and its length, so inserting at
+ * either end takes O(1).
  */
 
+#include "node_pool.h"
+
 #include <iostream>
 using namespace std;
 
@@ -23,6 +29,21 @@ struct Node
     Node *next; ///< Pointer to the next node
 };
 
+/**
+ * @struct DoublyLinkedList
+ * @brief The ends and length of a doubly linked list
+ *
+ * An empty list has null head and tail pointers and a size of 0.
+ */
+struct DoublyLinkedList
+{
+    Node *head = nullptr; ///< Pointer to the first node
+    Node *tail = nullptr; ///< Pointer to the last node
+    int size = 0;         ///< Number of nodes in the list
+};
+
+NodePool<Node> nodePool; ///< Allocates the nodes of every list in this program; freed at exit
+
 /**
  * @brief Creates a new node with the given value
  * @param value The integer value to be stored in the new node
@@ -30,70 +51,66 @@ struct Node
  */
 Node *createNode(int value)
 {
-    Node *newNode = new Node();
-    newNode->data = value;
-    newNode->prev = nullptr;
-    newNode->next = nullptr;
-    return newNode;
+    return nodePool.create(value, nullptr, nullptr);
 }
 
 /**
  * @brief Inserts a new node at the beginning of the doubly linked list
- * @param head Reference to the pointer to the head of the list
+ * @param list Reference to the list
  * @param value The value to be inserted
  */
-void insertFirst(Node *&head, int value)
+void insertFirst(DoublyLinkedList &list, int value)
 {
     Node *newNode = createNode(value);
 
-    if (head == nullptr)
+    if (list.head == nullptr)
     { // If the list is empty
-        head = newNode;
+        list.head = list.tail = newNode;
     }
     else
     {
-        newNode->next = head;
-        head->prev = newNode;
-        head = newNode;
+        newNode->next = list.head;
+        list.head->prev = newNode;
+        list.head = newNode;
     }
+    list.size++;
 
     cout << "Inserted " << value << " at the beginning." << endl;
 }
 
 /**
  * @brief Inserts a new node at the end of the doubly linked list
- * @param head Reference to the pointer to the head of the list
+ * @param list Reference to the list
  * @param value The value to be inserted
+ *
+ * Links the node after the tail instead of traversing to the end: O(1).
  */
-void insertLast(Node *&head, int value)
+void insertLast(DoublyLinkedList &list, int value)
 {
     Node *newNode = createNode(value);
 
-    if (head == nullptr)
+    if (list.tail == nullptr)
     { // If the list is empty
-        head = newNode;
+        list.head = list.tail = newNode;
     }
     else
     {
-        Node *temp = head;
-        while (temp->next != nullptr)
-        { // Traverse to the end
-            temp = temp->next;
-        }
-        temp->next = newNode;
-        newNode->prev = temp;
+        list.tail->next = newNode;
+        newNode->prev = list.tail;
+        list.tail = newNode;
     }
+    list.size++;
 
     cout << "Inserted " << value << " at the end." << endl;
 }
 
 /**
  * @brief Displays the contents of the doubly linked list
- * @param head Pointer to the head of the list
+ * @param list The list
  */
-void displayList(Node *head)
+void displayList(const DoublyLinkedList &list)
 {
-    Node *temp = head;
+    Node *temp = list.head;
     while (temp != nullptr)
     {
         cout << temp->data;
@@ -124,7 +141,7 @@ void menu()
  */
 int main()
 {
-    Node *head = nullptr;
+    DoublyLinkedList list;
     int choice, value;
 
     while (true)
@@ -138,16 +155,16 @@ int main()
         case 1:
             cout << "Enter value to insert at the beginning: ";
             cin >> value;
-            insertFirst(head, value);
+            insertFirst(list, value);
             break;
         case 2:
             cout << "Enter value to insert at the end: ";
             cin >> value;
-            insertLast(head, value);
+            insertLast(list, value);
             break;
         case 3:
             cout << "Doubly Linked List: ";
-            displayList(head);
+            displayList(list);
             break;
         case 4:
             cout << "Exiting..." << endl;
@@ -5,6 +5,10 @@
  * This file contains functions to insert nodes before and after specific values
  * in a doubly linked list. It provides detailed implementations for insertBefore
  * and insertAfter operations.
+ *
+ * Both work on the DoublyLinkedList of doubly_linked_list_insert_menu.cpp and
+ * keep its head, tail and size up to date, so the O(1) deleteLast and
+ * countNodes of doubly_linked_list_operations.cpp stay correct.
  */
 
 /**
@@ -13,7 +17,7 @@
  * This function inserts a new node with the given value before the first occurrence
  * of a node with the specified value in the doubly linked list.
  *
- * @param head Reference to the head pointer of the doubly linked list
+ * @param list Reference to the list
  * @param specificValue The value to search for in the list
  * @param newValue The value to be inserted in the new node
  *
@@ -22,15 +26,15 @@
  * @note If the insertion happens at the beginning of the list, the head pointer
  *       is updated accordingly.
  */
-void insertBefore(Node *&head, int specificValue, int newValue)
+void insertBefore(DoublyLinkedList &list, int specificValue, int newValue)
 {
-    if (head == nullptr)
+    if (list.head == nullptr)
     {
         cout << "List is empty." << endl;
         return;
     }
 
-    Node *temp = head;
+    Node *temp = list.head;
 
     // Traverse to find the node with the specific value
     while (temp != nullptr && temp->data != specificValue)
@@ -57,10 +61,11 @@ void insertBefore(Node *&head, int specificValue, int newValue)
     }
     else
     {
-        head = newNode; // Update head if inserted at the beginning
+        list.head = newNode; // Update head if inserted at the beginning
     }
 
     temp->prev = newNode;
+    list.size++;
     cout << "Inserted " << newValue << " before " << specificValue << "." << endl;
 }
 
@@ -70,24 +75,24 @@ void insertBefore(Node *&head, int specificValue, int newValue)
  * This function inserts a new node with the given value after the first occurrence
  * of a node with the specified value in the doubly linked list.
  *
- * @param head Pointer to the head of the doubly linked list
+ * @param list Reference to the list
  * @param specificValue The value to search for in the list
  * @param newValue The value to be inserted in the new node
  *
  * @note If the list is empty or the specific value is not found, appropriate
  *       messages are displayed and no insertion takes place.
- * @note This function does not modify the head pointer, as insertion always
- *       happens after an existing node.
+ * @note The head pointer never changes, as insertion always happens after an
+ *       existing node; the tail pointer is updated if that node was the last.
  */
-void insertAfter(Node *head, int specificValue, int newValue)
+void insertAfter(DoublyLinkedList &list, int specificValue, int newValue)
 {
-    if (head == nullptr)
+    if (list.head == nullptr)
     {
         cout << "List is empty." << endl;
         return;
     }
 
-    Node *temp = head;
+    Node *temp = list.head;
 
     // Traverse to find the node with the specific value
     while (temp != nullptr && temp->data != specificValue)
@@ -112,8 +117,13 @@ void insertAfter(Node *head, int specificValue, int newValue)
     {
         temp->next->prev = newNode;
     }
+    else
+    {
+        list.tail = newNode; // Update tail if inserted at the end
+    }
 
     temp->next = newNode;
+    list.size++;
 
     cout << "Inserted " << newValue << " after " << specificValue << "." << endl;
 }
@@ -122,14 +132,15 @@ void insertAfter(Node *head, int specificValue, int newValue)
  * @brief Usage Instructions
  *
  * To use these functions:
- * 1. Ensure you have a Node structure defined with 'data', 'next', and 'prev' members.
+ * 1. Ensure you have a Node structure defined with 'data', 'next', and 'prev' members,
+ *    and a DoublyLinkedList structure with 'head', 'tail' and 'size' members.
  * 2. Implement a createNode function that allocates and initializes a new Node.
- * 3. Maintain a head pointer to your doubly linked list.
+ * 3. Start from an empty DoublyLinkedList with null head and tail pointers and a size of 0.
  * 4. Call insertBefore or insertAfter as needed, providing the necessary parameters.
  *
  * Example:
- *     Node* head = nullptr;
+ *     DoublyLinkedList list;
  *     // ... populate the list ...
- *     insertBefore(head, 5, 10);  // Insert 10 before the first occurrence of 5
- *     insertAfter(head, 7, 15);   // Insert 15 after the first occurrence of 7
+ *     insertBefore(list, 5, 10);  // Insert 10 before the first occurrence of 5
+ *     insertAfter(list, 7, 15);   // Insert 15 after the first occurrence of 7
  */
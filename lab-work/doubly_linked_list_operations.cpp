@@ -4,6 +4,12 @@
  *
  * This file contains functions to perform operations on a doubly linked list,
  * including searching, deleting nodes, and counting nodes.
+ *
+ * The list keeps pointers to both ends and its length, so deleting the
+ * last node and counting take O(1).
+ *
+ * Nodes come from the NodePool of doubly_linked_list_insert_menu.cpp, so the
+ * delete functions hand them back with nodePool.destroy rather than delete.
  */
 
 /**
@@ -16,15 +22,35 @@
  * @brief - Node* next: Pointer to the next node
  */
 
+/**
+ * @struct DoublyLinkedList
+ * @brief The ends and length of a doubly linked list
+ *
+ * This structure should be defined elsewhere in the code, as in
+ * doubly_linked_list_insert_menu.cpp, containing:
+ * - Node* head: Pointer to the first node
+ * - Node* tail: Pointer to the last node
+ * - int size: Number of nodes in the list
+ */
+
+/**
+ * @var nodePool
+ * @brief The NodePool<Node> (node_pool.h) that created every node of the list
+ *
+ * This pool should be defined elsewhere in the code, as in
+ * doubly_linked_list_insert_menu.cpp. Nodes made with new instead would need
+ * delete here in place of nodePool.destroy.
+ */
+
 /**
  * @brief Searches for a value in the doubly linked list
- * @param head Pointer to the head of the list
+ * @param list The list
  * @param value The value to search for
  * @return true if the value is found, false otherwise
  */
-bool search(Node *head, int value)
+bool search(const DoublyLinkedList &list, int value)
 {
-    Node *temp = head;
+    Node *temp = list.head;
     while (temp != nullptr)
     {
         if (temp->data == value)
@@ -38,78 +64,79 @@ bool search(Node *head, int value)
 
 /**
  * @brief Deletes the first node of the doubly linked list
- * @param head Reference to the pointer to the head of the list
+ * @param list Reference to the list
  */
-void deleteFirst(Node *&head)
+void deleteFirst(DoublyLinkedList &list)
 {
-    if (head == nullptr)
+    if (list.head == nullptr)
     {
         cout << "List is empty. No node to delete." << endl;
         return;
     }
 
-    Node *temp = head;
-    head = head->next;
+    Node *temp = list.head;
+    list.head = list.head->next;
 
-    if (head != nullptr)
+    if (list.head != nullptr)
+    {
+        list.head->prev = nullptr;
+    }
+    else
     {
-        head->prev = nullptr;
+        list.tail = nullptr;
     }
+    list.size--;
 
-    delete temp;
+    nodePool.destroy(temp);
     cout << "Deleted the first node." << endl;
 }
 
 /**
  * @brief Deletes the last node of the doubly linked list
- * @param head Reference to the pointer to the head of the list
+ * @param list Reference to the list
+ *
+ * The tail's prev pointer gives the new tail without a traversal: O(1).
  */
-void deleteLast(Node *&head)
+void deleteLast(DoublyLinkedList &list)
 {
-    if (head == nullptr)
+    if (list.tail == nullptr)
     {
         cout << "List is empty. No node to delete." << endl;
         return;
     }
 
-    Node *temp = head;
+    Node *temp = list.tail;
+    list.tail = temp->prev;
 
     // If there's only one node
-    if (temp->next == nullptr)
+    if (list.tail == nullptr)
     {
-        delete head;
-        head = nullptr;
-        cout << "Deleted the last node." << endl;
-        return;
+        list.head = nullptr;
     }
-
-    // Traverse to the last node
-    while (temp->next != nullptr)
+    else
     {
-        temp = temp->next;
+        list.tail->next = nullptr;
     }
-
-    // Update the pointers
-    temp->prev->next = nullptr;
-    delete temp;
+    list.size--;
+    nodePool.destroy(temp);
 
     cout << "Deleted the last node." << endl;
 }
 
 /**
  * @brief Deletes a specific node with the given value from the doubly linked list
- * @param head Reference to the pointer to the head of the list
+ * @param list Reference to the list
  * @param value The value of the node to be deleted
  */
-void deleteSpecific(Node *&head, int value)
+void deleteSpecific(DoublyLinkedList &list, int value)
 {
-    if (head == nullptr)
+    if (list.head == nullptr)
     {
         cout << "List is empty. No node to delete." << endl;
         return;
     }
 
-    Node *temp = head;
+    Node *temp = list.head;
 
     // Traverse to find the node with the specific value
     while (temp != nullptr && temp->data != value)
@@ -130,41 +157,40 @@ void deleteSpecific(Node *&head, int value)
     }
     else
     {
-        head = temp->next; // Update head if deleting the first node
+        list.head = temp->next; // Update head if deleting the first node
     }
 
     if (temp->next != nullptr)
     {
         temp->next->prev = temp->prev;
     }
+    else
+    {
+        list.tail = temp->prev; // Update tail if deleting the last node
+    }
+    list.size--;
 
-    delete temp;
+    nodePool.destroy(temp);
     cout << "Deleted node with value " << value << "." << endl;
 }
 
 /**
  * @brief Counts the number of nodes in the doubly linked list
- * @param head Pointer to the head of the list
- * @return The number of nodes in the list
+ * @param list The list
+ * @return The number of nodes in the list, kept up to date by every operation: O(1)
  */
-int countNodes(Node *head)
+int countNodes(const DoublyLinkedList &list)
 {
-    int count = 0;
-    Node *temp = head;
-    while (temp != nullptr)
-    {
-        count++;
-        temp = temp->next;
-    }
-    return count;
+    return list.size;
 }
 
 /**
  * @brief Usage Instructions
  *
  * To use these functions:
- * 1. Ensure that the Node structure is properly defined.
- * 2. Create a doubly linked list by initializing a head pointer to nullptr.
+ * 1. Ensure that the Node and DoublyLinkedList structures and the nodePool are properly defined.
+ * 2. Create an empty doubly linked list with null head and tail pointers and a size of 0,
+ *    and create its nodes with nodePool.create.
  * 3. Use the provided functions as needed:
  *    - search(): To find a value in the list
  *    - deleteFirst(): To remove the first node
@@ -174,14 +200,14 @@ int countNodes(Node *head)
  *
  * Example:
  * @code
- * Node* head = nullptr;
+ * DoublyLinkedList list;
  * // Add nodes to the list (implementation not provided in this file)
- * if (search(head, 5)) {
+ * if (search(list, 5)) {
  *     cout << "Value 5 found in the list." << endl;
  * }
- * deleteFirst(head);
- * deleteLast(head);
- * deleteSpecific(head, 3);
- * cout << "Number of nodes: " << countNodes(head) << endl;
+ * deleteFirst(list);
+ * deleteLast(list);
+ * deleteSpecific(list, 3);
+ * cout << "Number of nodes: " << countNodes(list) << endl;
  * @endcode
  */
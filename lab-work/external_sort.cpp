@@ -0,0 +1,718 @@
+/**
+ * @file external_sort.cpp
+ * @brief External-memory (out-of-core) sort of binary int files larger than RAM
+ *
+ * The other sorts in lab-work need the whole array in memory. This program
+ * sorts a file of native-endian 32-bit ints using a fixed memory budget:
+ *
+ * 1. Run formation: the file is read in chunks that fit in the budget, each
+ *    chunk is sorted in memory with the quicksort kernel (sorting::introSort
+ *    from generic_sort.h) and written out as a sorted run file.
+ * 2. Merging: runs are merged k at a time with a loser tree, which finds the
+ *    next smallest key with log2(k) comparisons and no heap sift-down. Every
+ *    run is read and the output written through large sequential buffers, so
+ *    the disk sees long streaming transfers rather than small random ones.
+ *    If there are more runs than buffers fit in memory, merging takes more
+ *    than one pass, each pass reducing the number of runs by a factor of k.
+ *
+ * The bytes read and written and the number of passes over the data are
+ * reported, since for data on disk they, not comparisons, decide the time.
+ */
+
+#include "generic_sort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+const size_t DEFAULT_MEMORY_BYTES = 256u << 20; ///< Default memory budget: 256 MiB
+const size_t MIN_MERGE_BUFFER_BYTES = 1u << 20; ///< Smallest per-run read buffer during merging
+const size_t GENERATE_BUFFER_INTS = 1u << 20;   ///< Ints written per call when generating a test file
+
+/**
+ * @struct IoStats
+ * @brief I/O done by one external sort
+ */
+struct IoStats
+{
+    unsigned long long bytesRead = 0;    ///< Bytes read from the input and run files
+    unsigned long long bytesWritten = 0; ///< Bytes written to run files and the output
+    int passes = 0;                      ///< Passes over the data, run formation included
+    int initialRuns = 0;                 ///< Sorted runs produced by run formation
+};
+
+/**
+ * @class RunReader
+ * @brief Sequential reader of ints from a file through a large buffer
+ */
+class RunReader
+{
+private:
+    FILE *file;          ///< The open file
+    vector<int> buffer;  ///< Ints read ahead from the file
+    size_t position;     ///< Next unread int in the buffer
+    size_t count;        ///< Valid ints in the buffer
+    bool failed;         ///< Set when a read fails
+    size_t leftover;     ///< Bytes at the end of the file too few to make an int
+    IoStats &stats;      ///< Where bytes read are counted
+
+    /**
+     * @brief Reads up to n whole ints into arr, noting read errors and a partial last int
+     * @return The number of ints read
+     *
+     * Reads bytes rather than ints, so that fread does not silently drop
+     * the bytes of an incomplete last int.
+     */
+    size_t readInts(int arr[], size_t n)
+    {
+        size_t bytes = fread(arr, 1, n * sizeof(int), file);
+        stats.bytesRead += bytes;
+        if (ferror(file))
+        {
+            failed = true;
+        }
+        if (bytes % sizeof(int) != 0)
+        {
+            // Only the end of the file can hold a partial int, so this stays set
+            leftover = bytes % sizeof(int);
+        }
+        return bytes / sizeof(int);
+    }
+
+    /**
+     * @brief Reads the next block of the file into the buffer
+     * @return true if at least one int was read
+     */
+    bool refill()
+    {
+        count = readInts(buffer.data(), buffer.size());
+        position = 0;
+        return count > 0;
+    }
+
+public:
+    RunReader(const string &path, size_t bufferInts, IoStats &ioStats)
+        : file(fopen(path.c_str(), "rb")), buffer(max<size_t>(bufferInts, 1)), position(0), count(0), failed(false),
+          leftover(0), stats(ioStats)
+    {
+    }
+
+    ~RunReader()
+    {
+        if (file)
+        {
+            fclose(file);
+        }
+    }
+
+    RunReader(const RunReader &) = delete;
+    RunReader &operator=(const RunReader &) = delete;
+
+    /// @return true if the file was opened
+    bool isOpen() const { return file != nullptr; }
+
+    /// @return true if a read failed; the ints before it were returned, the rest are missing
+    bool hasReadError() const { return failed; }
+
+    /// @return The bytes after the last whole int, once the end of the file is reached
+    size_t trailingBytes() const { return leftover; }
+
+    /**
+     * @brief Reads the next int
+     * @param value Receives the int
+     * @return false at the end of the file or on a read error
+     */
+    bool next(int &value)
+    {
+        if (position == count && !refill())
+        {
+            return false;
+        }
+        value = buffer[position++];
+        return true;
+    }
+
+    /**
+     * @brief Reads up to n ints into arr
+     * @return The number of ints read; less than n only at the end of the file or on a read error
+     */
+    size_t read(int arr[], size_t n)
+    {
+        return readInts(arr, n);
+    }
+};
+
+/**
+ * @class RunWriter
+ * @brief Sequential writer of ints to a file through a large buffer
+ */
+class RunWriter
+{
+private:
+    FILE *file;          ///< The open file
+    vector<int> buffer;  ///< Ints waiting to be written
+    size_t count;        ///< Valid ints in the buffer
+    bool failed;         ///< Set when a write fails
+    IoStats &stats;      ///< Where bytes written are counted
+
+public:
+    RunWriter(const string &path, size_t bufferInts, IoStats &ioStats)
+        : file(fopen(path.c_str(), "wb")), buffer(max<size_t>(bufferInts, 1)), count(0), failed(file == nullptr),
+          stats(ioStats)
+    {
+    }
+
+    ~RunWriter()
+    {
+        close();
+    }
+
+    RunWriter(const RunWriter &) = delete;
+    RunWriter &operator=(const RunWriter &) = delete;
+
+    /**
+     * @brief Appends one int
+     */
+    void write(int value)
+    {
+        buffer[count++] = value;
+        if (count == buffer.size())
+        {
+            flush();
+        }
+    }
+
+    /**
+     * @brief Appends n ints directly, bypassing the buffer
+     */
+    void write(const int arr[], size_t n)
+    {
+        flush();
+        if (file && fwrite(arr, sizeof(int), n, file) != n)
+        {
+            failed = true;
+        }
+        stats.bytesWritten += n * sizeof(int);
+    }
+
+    /**
+     * @brief Writes the buffered ints to the file
+     */
+    void flush()
+    {
+        if (file && count > 0 && fwrite(buffer.data(), sizeof(int), count, file) != count)
+        {
+            failed = true;
+        }
+        stats.bytesWritten += count * sizeof(int);
+        count = 0;
+    }
+
+    /**
+     * @brief Flushes and closes the file
+     * @return true if every write succeeded
+     */
+    bool close()
+    {
+        if (file)
+        {
+            flush();
+            if (fclose(file) != 0)
+            {
+                failed = true;
+            }
+            file = nullptr;
+        }
+        return !failed;
+    }
+};
+
+/**
+ * @class LoserTree
+ * @brief Tournament tree that repeatedly yields the source with the smallest current key
+ *
+ * Leaves are the k sources; each internal node stores the loser of the match
+ * played there and node 0 stores the overall winner. After the winner's
+ * source advances, only the matches on its path to the root are replayed,
+ * one comparison per level, against the losers already stored there.
+ * Exhausted sources compare greater than every key.
+ */
+class LoserTree
+{
+private:
+    int k;                ///< Number of sources
+    vector<int> tree;     ///< tree[0] is the winner, tree[1..k-1] the losers of internal matches
+    vector<int> keys;     ///< Current key of each source
+    vector<char> done;    ///< Whether each source is exhausted
+
+    /**
+     * @brief Whether source a's key comes before source b's
+     */
+    bool beats(int a, int b) const
+    {
+        if (done[a] || done[b])
+        {
+            return !done[a];
+        }
+        return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+    }
+
+    /**
+     * @brief Plays the matches of a subtree, storing losers
+     * @param node The subtree root; nodes k..2k-1 are the leaves
+     * @return The winning source of the subtree
+     */
+    int build(int node)
+    {
+        if (node >= k)
+        {
+            return node - k;
+        }
+        int left = build(2 * node);
+        int right = build(2 * node + 1);
+        if (beats(left, right))
+        {
+            tree[node] = right;
+            return left;
+        }
+        tree[node] = left;
+        return right;
+    }
+
+public:
+    explicit LoserTree(int sources) : k(sources), tree(sources), keys(sources), done(sources, 1) {}
+
+    /**
+     * @brief Sets the first key of a source before start() is called
+     * @param exhausted true if the source is empty
+     */
+    void setSource(int source, int key, bool exhausted)
+    {
+        keys[source] = key;
+        done[source] = exhausted;
+    }
+
+    /**
+     * @brief Plays the initial tournament
+     */
+    void start()
+    {
+        tree[0] = build(1);
+    }
+
+    /// @return The source holding the smallest key
+    int winner() const { return tree[0]; }
+
+    /// @return The smallest key
+    int winnerKey() const { return keys[tree[0]]; }
+
+    /// @return true once every source is exhausted
+    bool empty() const { return done[tree[0]] != 0; }
+
+    /**
+     * @brief Replaces the winner's key with its source's next key and replays its path
+     * @param key The next key of the winning source
+     * @param exhausted true if the winning source has no more keys
+     */
+    void replaceWinner(int key, bool exhausted)
+    {
+        int winning = tree[0];
+        keys[winning] = key;
+        done[winning] = exhausted;
+
+        for (int node = (winning + k) / 2; node > 0; node /= 2)
+        {
+            if (beats(tree[node], winning))
+            {
+                swap(tree[node], winning);
+            }
+        }
+        tree[0] = winning;
+    }
+};
+
+/**
+ * @brief Deletes files left by a failed sort; files that do not exist are skipped
+ */
+void removeFiles(const vector<string> &paths)
+{
+    for (const string &path : paths)
+    {
+        remove(path.c_str());
+    }
+}
+
+/**
+ * @brief Checks a reader that has reached the end of its file, printing what went wrong
+ * @return true if every byte of the file was read as a whole int
+ */
+bool readCompletely(const RunReader &reader, const string &path)
+{
+    if (reader.hasReadError())
+    {
+        cout << "Error reading " << path << endl;
+        return false;
+    }
+    if (reader.trailingBytes() != 0)
+    {
+        cout << path << " ends with " << reader.trailingBytes() << " bytes that do not make a whole int" << endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Splits the input into sorted runs of at most chunkInts ints
+ * @param inputPath The file to be sorted
+ * @param runPrefix Run files are named runPrefix + number
+ * @param chunkInts The number of ints sorted in memory at a time
+ * @param runs Receives the run file names
+ * @param stats The I/O counters
+ * @return false if a file could not be read or written, or the input size is
+ *         not a whole number of ints; the runs written so far are then deleted
+ */
+bool createRuns(const string &inputPath, const string &runPrefix, size_t chunkInts, vector<string> &runs,
+                IoStats &stats)
+{
+    RunReader input(inputPath, 1, stats);
+    if (!input.isOpen())
+    {
+        cout << "Cannot open " << inputPath << endl;
+        return false;
+    }
+
+    vector<int> chunk(chunkInts);
+    while (true)
+    {
+        size_t n = input.read(chunk.data(), chunkInts);
+        if (n < chunkInts && !readCompletely(input, inputPath))
+        {
+            removeFiles(runs);
+            return false;
+        }
+        if (n == 0)
+        {
+            break;
+        }
+
+        sorting::introSort(chunk.begin(), chunk.begin() + (ptrdiff_t)n);
+
+        string runPath = runPrefix + to_string(runs.size());
+        RunWriter run(runPath, 1, stats);
+        run.write(chunk.data(), n);
+        runs.push_back(runPath);
+        if (!run.close())
+        {
+            cout << "Cannot write " << runPath << endl;
+            removeFiles(runs);
+            return false;
+        }
+        if (n < chunkInts)
+        {
+            break;
+        }
+    }
+
+    stats.passes++;
+    stats.initialRuns = (int)runs.size();
+    return true;
+}
+
+/**
+ * @brief Merges sorted run files into one sorted file with a loser tree
+ * @param runs The run files; they are deleted after merging
+ * @param outputPath The merged file
+ * @param bufferInts The read buffer size per run and the write buffer size
+ * @param stats The I/O counters
+ * @return false if a file could not be read or written; the output is then incomplete
+ */
+bool mergeRuns(const vector<string> &runs, const string &outputPath, size_t bufferInts, IoStats &stats)
+{
+    int k = (int)runs.size();
+    vector<unique_ptr<RunReader>> readers;
+    LoserTree tree(k);
+    bool ok = true;
+
+    for (int i = 0; i < k; i++)
+    {
+        readers.push_back(make_unique<RunReader>(runs[i], bufferInts, stats));
+        if (!readers[i]->isOpen())
+        {
+            // Reading a run that did not open would pass a null FILE to fread
+            cout << "Cannot open " << runs[i] << endl;
+            ok = false;
+            break;
+        }
+        int key = 0;
+        bool exhausted = !readers[i]->next(key);
+        tree.setSource(i, key, exhausted);
+    }
+
+    RunWriter output(outputPath, bufferInts, stats);
+    if (ok)
+    {
+        tree.start();
+        while (!tree.empty())
+        {
+            output.write(tree.winnerKey());
+            int key = 0;
+            bool exhausted = !readers[tree.winner()]->next(key);
+            tree.replaceWinner(key, exhausted);
+        }
+    }
+    for (int i = 0; i < (int)readers.size() && ok; i++)
+    {
+        // A read error or partial int ends a run early, losing its other keys
+        ok = readCompletely(*readers[i], runs[i]);
+    }
+    if (!output.close())
+    {
+        cout << "Cannot write " << outputPath << endl;
+        ok = false;
+    }
+
+    readers.clear();
+    for (int i = 0; i < k; i++)
+    {
+        remove(runs[i].c_str());
+    }
+    return ok;
+}
+
+/**
+ * @brief Sorts a binary file of ints using at most about memoryBytes of RAM
+ * @param inputPath The file to be sorted; it is not modified
+ * @param outputPath The sorted file; run files are created next to it
+ * @param memoryBytes The memory budget for the sort chunk and the merge buffers
+ * @param stats Receives the I/O counters
+ * @return true on success; on failure every run and merge file is deleted
+ *
+ * The merge fan-in is the number of MIN_MERGE_BUFFER_BYTES buffers that fit in
+ * the budget (at least 2); with F runs and fan-in k there are
+ * ceil(log_k(F)) merge passes after run formation.
+ */
+bool externalSort(const string &inputPath, const string &outputPath, size_t memoryBytes, IoStats &stats)
+{
+    stats = IoStats();
+    size_t chunkInts = max<size_t>(memoryBytes / sizeof(int), 1);
+    size_t fanIn = max<size_t>(memoryBytes / MIN_MERGE_BUFFER_BYTES, 3) - 1; // One buffer is for output
+
+    vector<string> runs;
+    if (!createRuns(inputPath, outputPath + ".run", chunkInts, runs, stats))
+    {
+        removeFiles(runs);
+        return false;
+    }
+    if (runs.empty())
+    {
+        // Empty input: the output is an empty file
+        RunWriter output(outputPath, 1, stats);
+        return output.close();
+    }
+
+    int generation = 0;
+    while (runs.size() > 1)
+    {
+        // Merge groups of fanIn runs; the final pass writes the output itself
+        size_t groups = (runs.size() + fanIn - 1) / fanIn;
+        size_t bufferInts = memoryBytes / sizeof(int) / (min(fanIn, runs.size()) + 1);
+        vector<string> merged;
+        generation++;
+
+        for (size_t g = 0; g < groups; g++)
+        {
+            vector<string> group(runs.begin() + (ptrdiff_t)(g * fanIn),
+                                 runs.begin() + (ptrdiff_t)min(runs.size(), (g + 1) * fanIn));
+            string target = groups == 1 ? outputPath : outputPath + ".merge" + to_string(generation) + "." + to_string(g);
+            if (group.size() == 1)
+            {
+                // A lone leftover run carries over to the next pass untouched
+                merged.push_back(group[0]);
+                continue;
+            }
+            if (!mergeRuns(group, target, bufferInts, stats))
+            {
+                // Drop the partial target and every run still waiting, which
+                // together can take as much disk as the input
+                remove(target.c_str());
+                removeFiles(runs);
+                removeFiles(merged);
+                return false;
+            }
+            merged.push_back(target);
+        }
+        stats.passes++;
+        runs = merged;
+    }
+
+    if (runs[0] != outputPath)
+    {
+        // A single run is already the sorted output
+        remove(outputPath.c_str());
+        if (rename(runs[0].c_str(), outputPath.c_str()) != 0)
+        {
+            cout << "Cannot rename " << runs[0] << " to " << outputPath << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Writes count random ints to a binary file
+ * @return true on success
+ */
+bool generateFile(const string &path, unsigned long long count, unsigned int seed)
+{
+    IoStats stats;
+    RunWriter output(path, GENERATE_BUFFER_INTS, stats);
+    mt19937 generator(seed);
+    for (unsigned long long i = 0; i < count; i++)
+    {
+        output.write((int)generator());
+    }
+    return output.close();
+}
+
+/**
+ * @brief Checks that a file is sorted and returns its length and the sum of its values
+ * @return true if the file could be read and is sorted
+ */
+bool verifyFile(const string &path, unsigned long long &count, unsigned long long &sum)
+{
+    IoStats stats;
+    RunReader input(path, GENERATE_BUFFER_INTS, stats);
+    count = 0;
+    sum = 0;
+    if (!input.isOpen())
+    {
+        return false;
+    }
+
+    bool sorted = true;
+    int previous = 0;
+    int value = 0;
+    while (input.next(value))
+    {
+        if (count > 0 && value < previous)
+        {
+            sorted = false;
+        }
+        previous = value;
+        sum += (unsigned long long)(long long)value;
+        count++;
+    }
+    return sorted && readCompletely(input, path);
+}
+
+/**
+ * @brief Prints the I/O counters of a sort
+ */
+void printStats(const IoStats &stats, double seconds)
+{
+    cout << "Initial runs:  " << stats.initialRuns << endl;
+    cout << "Passes:        " << stats.passes << " (1 run formation + " << stats.passes - 1 << " merge)" << endl;
+    cout << "Bytes read:    " << stats.bytesRead << endl;
+    cout << "Bytes written: " << stats.bytesWritten << endl;
+    cout << "Time:          " << seconds << " s" << endl;
+}
+
+/**
+ * @brief Main function: sorts a file given on the command line, or runs a self-checking demo
+ * @param argc Number of command-line arguments
+ * @param argv The arguments: [input output [memoryMiB]] or [--generate file count]
+ * @return 0 on success, 1 on failure
+ */
+int main(int argc, char *argv[])
+{
+    if (argc >= 2 && string(argv[1]) == "--generate")
+    {
+        if (argc < 4)
+        {
+            cout << "Usage: " << argv[0] << " --generate file count" << endl;
+            return 1;
+        }
+        return generateFile(argv[2], stoull(argv[3]), 42) ? 0 : 1;
+    }
+
+    string inputPath;
+    string outputPath;
+    size_t memoryBytes = DEFAULT_MEMORY_BYTES;
+    bool demo = argc < 3;
+    unsigned long long inputCount = 0;
+    unsigned long long inputSum = 0;
+
+    if (demo)
+    {
+        // Sort 64 MiB of random ints with an 8 MiB budget: 8 runs, a 7-way merge and a 2-way merge
+        inputPath = "external_sort_demo.bin";
+        outputPath = "external_sort_demo.sorted.bin";
+        memoryBytes = 8u << 20;
+        cout << "Generating " << inputPath << " (64 MiB of random ints)" << endl;
+        if (!generateFile(inputPath, 16u << 20, 42))
+        {
+            cout << "Cannot write " << inputPath << endl;
+            return 1;
+        }
+
+        // Length and sum of the input, to check that the output is a permutation of it
+        IoStats scan;
+        RunReader input(inputPath, GENERATE_BUFFER_INTS, scan);
+        int value = 0;
+        while (input.next(value))
+        {
+            inputSum += (unsigned long long)(long long)value;
+            inputCount++;
+        }
+    }
+    else
+    {
+        inputPath = argv[1];
+        outputPath = argv[2];
+        if (argc >= 4)
+        {
+            memoryBytes = (size_t)stoull(argv[3]) << 20;
+        }
+    }
+
+    cout << "Sorting " << inputPath << " into " << outputPath << " with " << (memoryBytes >> 20) << " MiB of memory"
+         << endl;
+    IoStats stats;
+    auto start = chrono::steady_clock::now();
+    bool ok = externalSort(inputPath, outputPath, memoryBytes, stats);
+    auto end = chrono::steady_clock::now();
+    if (!ok)
+    {
+        return 1;
+    }
+    printStats(stats, chrono::duration<double>(end - start).count());
+
+    if (demo)
+    {
+        unsigned long long outputCount = 0;
+        unsigned long long outputSum = 0;
+        bool sorted = verifyFile(outputPath, outputCount, outputSum);
+        bool correct = sorted && outputCount == inputCount && outputSum == inputSum;
+        cout << "Output check: " << (correct ? "sorted, same length and sum as input" : "WRONG") << endl;
+        remove(inputPath.c_str());
+        remove(outputPath.c_str());
+        return correct ? 0 : 1;
+    }
+    return 0;
+}
+
+/**
+ * Usage Instructions:
+ * 1. Compile the program with C++17 (e.g., g++ -std=c++17 -O2 external_sort.cpp -o external_sort)
+ * 2. Run it without arguments for a self-checking demo in the current directory (e.g., ./external_sort)
+ * 3. To sort your own file of native-endian 32-bit ints:
+ *        ./external_sort input.bin output.bin [memoryMiB]
+ *    Run files are written next to output.bin and need up to the input size in free disk space.
+ * 4. To create a random test file: ./external_sort --generate file.bin count
+ */
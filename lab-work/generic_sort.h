@@ -0,0 +1,1239 @@
+/**
+ * @file generic_sort.h
+ * @brief Header-only templated versions of the sorting algorithms in lab-work
+ *
+ * The sorts in bubble_sort.cpp, insertion_sort.cpp, selection_sort.cpp,
+ * quick_sort.cpp and radix_sort.cpp operate on int arrays with int sizes.
+ * This header provides the same algorithms over any random-access iterator
+ * range, with a comparator and a projection (key extractor), so records can
+ * be sorted by one of their fields without copying keys into an int array.
+ * All functions are templates, so the comparison is inlined for each key type.
+ *
+ * Every sort has the signature
+ *     sortName(first, last, comp = std::less<>(), proj = Identity())
+ * and orders the range so that comp(proj(a), proj(b)) holds for no a after b.
+ * Sizes and positions use the iterator difference type, so ranges are not
+ * limited to 2^31 elements.
+ *
+ * timSort is the stable, run-adaptive choice for mostly sorted input;
+ * introSort is the fastest general-purpose (unstable) choice.
+ *
+ * Requires C++17.
+ */
+
+#ifndef GENERIC_SORT_H
+#define GENERIC_SORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sorting
+{
+
+/**
+ * @struct Identity
+ * @brief The default projection: returns its argument unchanged
+ */
+struct Identity
+{
+    template <typename T>
+    constexpr T &&operator()(T &&value) const noexcept
+    {
+        return std::forward<T>(value);
+    }
+};
+
+/**
+ * @enum PartitionScheme
+ * @brief Selects the partition kernel used by quickSort
+ */
+enum class PartitionScheme
+{
+    Lomuto, ///< Classic single-scan partition, as in quick_sort.cpp
+    Block   ///< Branchless BlockQuicksort-style partition
+};
+
+const std::ptrdiff_t INSERTION_SORT_THRESHOLD = 16; ///< Subranges this small are finished by insertion sort
+const std::ptrdiff_t NINTHER_THRESHOLD = 128;       ///< Subranges larger than this use a ninther pivot
+const std::ptrdiff_t PARTITION_BLOCK_SIZE = 128;    ///< Elements classified per block by the block partition
+const std::ptrdiff_t TIMSORT_MIN_MERGE = 32;        ///< timSort ranges shorter than this use binary insertion sort only
+const std::ptrdiff_t TIMSORT_MIN_GALLOP = 7;        ///< Consecutive wins by one run before timSort starts galloping
+const std::size_t TIMSORT_MAX_RUNS = 85;            ///< Pending runs timSort can hold: enough for any 64-bit length
+
+namespace detail
+{
+
+/**
+ * @brief Combines a comparator and a projection into a two-argument predicate
+ * @param comp The comparator applied to projected keys
+ * @param proj The projection applied to each element
+ * @return A callable returning comp(proj(a), proj(b))
+ */
+template <typename Compare, typename Projection>
+auto projectedLess(Compare &comp, Projection &proj)
+{
+    return [&comp, &proj](const auto &a, const auto &b) -> bool
+    {
+        return std::invoke(comp, std::invoke(proj, a), std::invoke(proj, b));
+    };
+}
+
+/**
+ * @brief Insertion sort on [first, last)
+ */
+template <typename RandomIt, typename Less>
+void insertionSortRange(RandomIt first, RandomIt last, Less less)
+{
+    if (first == last)
+    {
+        return;
+    }
+    for (RandomIt i = first + 1; i != last; ++i)
+    {
+        auto key = std::move(*i);
+        RandomIt j = i;
+        while (j != first && less(key, *(j - 1)))
+        {
+            *j = std::move(*(j - 1));
+            --j;
+        }
+        *j = std::move(key);
+    }
+}
+
+/**
+ * @brief Moves first[root] down the max-heap of n elements
+ */
+template <typename RandomIt, typename Less>
+void siftDown(RandomIt first, typename std::iterator_traits<RandomIt>::difference_type root,
+              typename std::iterator_traits<RandomIt>::difference_type n, Less less)
+{
+    auto value = std::move(first[root]);
+    auto child = 2 * root + 1;
+
+    while (child < n)
+    {
+        if (child + 1 < n && less(first[child], first[child + 1]))
+        {
+            child++;
+        }
+        if (!less(value, first[child]))
+        {
+            break;
+        }
+        first[root] = std::move(first[child]);
+        root = child;
+        child = 2 * root + 1;
+    }
+    first[root] = std::move(value);
+}
+
+/**
+ * @brief Heap sort on [first, last)
+ */
+template <typename RandomIt, typename Less>
+void heapSortRange(RandomIt first, RandomIt last, Less less)
+{
+    auto n = last - first;
+    for (auto i = n / 2 - 1; i >= 0; i--)
+    {
+        siftDown(first, i, n, less);
+    }
+    for (auto end = n - 1; end > 0; end--)
+    {
+        std::iter_swap(first, first + end);
+        siftDown(first, decltype(n)(0), end, less);
+    }
+}
+
+/**
+ * @brief Returns the iterator to the median of *a, *b and *c
+ */
+template <typename RandomIt, typename Less>
+RandomIt medianOfThree(RandomIt a, RandomIt b, RandomIt c, Less less)
+{
+    if (less(*a, *b))
+    {
+        if (less(*b, *c))
+        {
+            return b;
+        }
+        return less(*a, *c) ? c : a;
+    }
+    if (less(*a, *c))
+    {
+        return a;
+    }
+    return less(*b, *c) ? c : b;
+}
+
+/**
+ * @brief Median-of-three pivot for small ranges, Tukey's ninther for large ones
+ */
+template <typename RandomIt, typename Less>
+RandomIt choosePivot(RandomIt first, RandomIt last, Less less)
+{
+    auto n = last - first;
+    RandomIt mid = first + n / 2;
+    RandomIt back = last - 1;
+
+    if (n <= NINTHER_THRESHOLD)
+    {
+        return medianOfThree(first, mid, back, less);
+    }
+
+    auto step = n / 8;
+    RandomIt a = medianOfThree(first, first + step, first + 2 * step, less);
+    RandomIt b = medianOfThree(mid - step, mid, mid + step, less);
+    RandomIt c = medianOfThree(back - 2 * step, back - step, back, less);
+    return medianOfThree(a, b, c, less);
+}
+
+/**
+ * @brief Three-way partition of [first, last) around a chosen pivot
+ *
+ * On return [first, lt) is less than the pivot, [lt, gt) is equal to it and
+ * [gt, last) is greater. The pivot is kept at *lt throughout, so the value
+ * type never needs to be copied.
+ */
+template <typename RandomIt, typename Less>
+void partition3Way(RandomIt first, RandomIt last, RandomIt &lt, RandomIt &gt, Less less)
+{
+    std::iter_swap(first, choosePivot(first, last, less));
+    lt = first;
+    gt = last - 1;
+    RandomIt i = first + 1;
+
+    while (i <= gt)
+    {
+        if (less(*i, *lt))
+        {
+            std::iter_swap(lt++, i++);
+        }
+        else if (less(*lt, *i))
+        {
+            std::iter_swap(i, gt--);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+    ++gt;
+}
+
+/**
+ * @brief Core loop of introSort: recurse on the smaller side, loop on the larger
+ */
+template <typename RandomIt, typename Less>
+void introSortLoop(RandomIt first, RandomIt last, int depthLimit, Less less)
+{
+    while (last - first > INSERTION_SORT_THRESHOLD)
+    {
+        if (depthLimit == 0)
+        {
+            heapSortRange(first, last, less);
+            return;
+        }
+        depthLimit--;
+
+        RandomIt lt, gt;
+        partition3Way(first, last, lt, gt, less);
+
+        if (lt - first < last - gt)
+        {
+            introSortLoop(first, lt, depthLimit, less);
+            first = gt;
+        }
+        else
+        {
+            introSortLoop(gt, last, depthLimit, less);
+            last = lt;
+        }
+    }
+    insertionSortRange(first, last, less);
+}
+
+/**
+ * @brief Lomuto partition of [first, last) around *(last - 1)
+ * @return The final position of the pivot
+ */
+template <typename RandomIt, typename Less>
+RandomIt lomutoPartition(RandomIt first, RandomIt last, Less less)
+{
+    RandomIt pivot = last - 1;
+    RandomIt store = first;
+    for (RandomIt j = first; j != pivot; ++j)
+    {
+        if (less(*j, *pivot))
+        {
+            std::iter_swap(store++, j);
+        }
+    }
+    std::iter_swap(store, pivot);
+    return store;
+}
+
+/**
+ * @brief Branchless block partition of [first, last) around *(last - 1)
+ *
+ * Same contract as lomutoPartition. Misplaced elements are found by adding
+ * comparison results to counters and swapped in pairs without branching on
+ * individual comparisons; see blockPartition in quick_sort.h.
+ *
+ * @return The final position of the pivot
+ */
+template <typename RandomIt, typename Less>
+RandomIt blockPartition(RandomIt first, RandomIt last, Less less)
+{
+    RandomIt pivot = last - 1;
+    RandomIt left = first;
+    RandomIt right = last - 2;
+
+    unsigned char offsetsLeft[PARTITION_BLOCK_SIZE];
+    unsigned char offsetsRight[PARTITION_BLOCK_SIZE];
+    std::ptrdiff_t startLeft = 0, numLeft = 0;
+    std::ptrdiff_t startRight = 0, numRight = 0;
+
+    while (right - left + 1 >= 2 * PARTITION_BLOCK_SIZE)
+    {
+        if (numLeft == 0)
+        {
+            startLeft = 0;
+            for (std::ptrdiff_t i = 0; i < PARTITION_BLOCK_SIZE; i++)
+            {
+                offsetsLeft[numLeft] = (unsigned char)i;
+                numLeft += !less(left[i], *pivot);
+            }
+        }
+        if (numRight == 0)
+        {
+            startRight = 0;
+            for (std::ptrdiff_t i = 0; i < PARTITION_BLOCK_SIZE; i++)
+            {
+                offsetsRight[numRight] = (unsigned char)i;
+                numRight += less(*(right - i), *pivot);
+            }
+        }
+
+        std::ptrdiff_t num = std::min(numLeft, numRight);
+        for (std::ptrdiff_t k = 0; k < num; k++)
+        {
+            std::iter_swap(left + offsetsLeft[startLeft + k], right - offsetsRight[startRight + k]);
+        }
+        numLeft -= num;
+        numRight -= num;
+        startLeft += num;
+        startRight += num;
+
+        if (numLeft == 0)
+        {
+            left += PARTITION_BLOCK_SIZE;
+        }
+        if (numRight == 0)
+        {
+            right -= PARTITION_BLOCK_SIZE;
+        }
+    }
+
+    // Fewer than two blocks remain: finish them with the Lomuto scheme
+    RandomIt store = left;
+    for (RandomIt j = left; j <= right; ++j)
+    {
+        if (less(*j, *pivot))
+        {
+            std::iter_swap(store++, j);
+        }
+    }
+    std::iter_swap(store, pivot);
+    return store;
+}
+
+/**
+ * @brief Recursive quicksort with the selected partition kernel
+ */
+template <typename RandomIt, typename Less>
+void quickSortRange(RandomIt first, RandomIt last, PartitionScheme scheme, Less less)
+{
+    if (last - first > 1)
+    {
+        RandomIt pivot = scheme == PartitionScheme::Block ? blockPartition(first, last, less)
+                                                          : lomutoPartition(first, last, less);
+        quickSortRange(first, pivot, scheme, less);
+        quickSortRange(pivot + 1, last, scheme, less);
+    }
+}
+
+/**
+ * @brief Returns 2 * floor(log2(n)), the introsort depth limit for n elements
+ */
+inline int introSortDepthLimit(std::ptrdiff_t n)
+{
+    int log2n = 0;
+    for (; n > 1; n >>= 1)
+    {
+        log2n++;
+    }
+    return 2 * log2n;
+}
+
+/**
+ * @brief Computes timSort's minimum run length for n elements
+ *
+ * Returns n itself below 64, otherwise a value in [32, 64] such that n / minRun
+ * is a power of two or slightly less, which keeps the final merges balanced.
+ */
+inline std::ptrdiff_t timSortMinRun(std::ptrdiff_t n)
+{
+    std::ptrdiff_t extra = 0;
+    while (n >= 64)
+    {
+        extra |= n & 1;
+        n >>= 1;
+    }
+    return n + extra;
+}
+
+/**
+ * @brief Finds the run starting at first and makes it ascending
+ *
+ * A run is either non-descending or strictly descending; descending runs are
+ * reversed in place, which keeps the sort stable.
+ *
+ * @return The length of the run
+ */
+template <typename RandomIt, typename Less>
+std::ptrdiff_t countRunAndMakeAscending(RandomIt first, RandomIt last, Less less)
+{
+    RandomIt runEnd = first + 1;
+    if (runEnd == last)
+    {
+        return 1;
+    }
+
+    if (less(*runEnd, *first))
+    {
+        while (++runEnd != last && less(*runEnd, *(runEnd - 1)))
+        {
+        }
+        std::reverse(first, runEnd);
+    }
+    else
+    {
+        while (++runEnd != last && !less(*runEnd, *(runEnd - 1)))
+        {
+        }
+    }
+    return runEnd - first;
+}
+
+/**
+ * @brief Binary insertion sort of [first, last) where [first, start) is already sorted
+ *
+ * Inserting after equal elements (upper bound) keeps the sort stable.
+ */
+template <typename RandomIt, typename Less>
+void binaryInsertionSort(RandomIt first, RandomIt last, RandomIt start, Less less)
+{
+    for (RandomIt it = start; it != last; ++it)
+    {
+        auto pivot = std::move(*it);
+        RandomIt pos = std::upper_bound(first, it, pivot, less);
+        std::move_backward(pos, it, it + 1);
+        *pos = std::move(pivot);
+    }
+}
+
+/**
+ * @brief Leftmost position in sorted base[0..len) where key can be inserted
+ *
+ * Gallops from base[hint] in steps of 1, 3, 7, 15 ... then binary searches
+ * the last step, so finding a position k away from hint costs O(log k).
+ *
+ * @return k such that base[k - 1] < key <= base[k]
+ */
+template <typename Key, typename It, typename Less>
+std::ptrdiff_t gallopLeft(const Key &key, It base, std::ptrdiff_t len, std::ptrdiff_t hint, Less less)
+{
+    std::ptrdiff_t lastOffset = 0;
+    std::ptrdiff_t offset = 1;
+
+    if (less(base[hint], key))
+    {
+        // Gallop right until base[hint + lastOffset] < key <= base[hint + offset]
+        std::ptrdiff_t maxOffset = len - hint;
+        while (offset < maxOffset && less(base[hint + offset], key))
+        {
+            lastOffset = offset;
+            offset = 2 * offset + 1;
+        }
+        offset = std::min(offset, maxOffset);
+        lastOffset += hint;
+        offset += hint;
+    }
+    else
+    {
+        // Gallop left until base[hint - offset] < key <= base[hint - lastOffset]
+        std::ptrdiff_t maxOffset = hint + 1;
+        while (offset < maxOffset && !less(base[hint - offset], key))
+        {
+            lastOffset = offset;
+            offset = 2 * offset + 1;
+        }
+        offset = std::min(offset, maxOffset);
+        std::ptrdiff_t temp = lastOffset;
+        lastOffset = hint - offset;
+        offset = hint - temp;
+    }
+
+    // Binary search in (lastOffset, offset]
+    lastOffset++;
+    while (lastOffset < offset)
+    {
+        std::ptrdiff_t mid = lastOffset + (offset - lastOffset) / 2;
+        if (less(base[mid], key))
+        {
+            lastOffset = mid + 1;
+        }
+        else
+        {
+            offset = mid;
+        }
+    }
+    return offset;
+}
+
+/**
+ * @brief Rightmost position in sorted base[0..len) where key can be inserted
+ *
+ * Same galloping search as gallopLeft, but lands after elements equal to key.
+ *
+ * @return k such that base[k - 1] <= key < base[k]
+ */
+template <typename Key, typename It, typename Less>
+std::ptrdiff_t gallopRight(const Key &key, It base, std::ptrdiff_t len, std::ptrdiff_t hint, Less less)
+{
+    std::ptrdiff_t lastOffset = 0;
+    std::ptrdiff_t offset = 1;
+
+    if (less(key, base[hint]))
+    {
+        // Gallop left until base[hint - offset] <= key < base[hint - lastOffset]
+        std::ptrdiff_t maxOffset = hint + 1;
+        while (offset < maxOffset && less(key, base[hint - offset]))
+        {
+            lastOffset = offset;
+            offset = 2 * offset + 1;
+        }
+        offset = std::min(offset, maxOffset);
+        std::ptrdiff_t temp = lastOffset;
+        lastOffset = hint - offset;
+        offset = hint - temp;
+    }
+    else
+    {
+        // Gallop right until base[hint + lastOffset] <= key < base[hint + offset]
+        std::ptrdiff_t maxOffset = len - hint;
+        while (offset < maxOffset && !less(key, base[hint + offset]))
+        {
+            lastOffset = offset;
+            offset = 2 * offset + 1;
+        }
+        offset = std::min(offset, maxOffset);
+        lastOffset += hint;
+        offset += hint;
+    }
+
+    lastOffset++;
+    while (lastOffset < offset)
+    {
+        std::ptrdiff_t mid = lastOffset + (offset - lastOffset) / 2;
+        if (less(key, base[mid]))
+        {
+            offset = mid;
+        }
+        else
+        {
+            lastOffset = mid + 1;
+        }
+    }
+    return offset;
+}
+
+/**
+ * @class TimSortMerger
+ * @brief The run stack and merge procedures of timSort
+ *
+ * Runs are pushed as they are found. mergeCollapse keeps the stack lengths
+ * growing at least like the Fibonacci numbers, so the stack stays O(log n)
+ * deep and merges stay balanced. Merges copy the shorter run into the
+ * scratch buffer and switch to galloping when one run keeps winning.
+ */
+template <typename RandomIt, typename Less, typename Buffer>
+class TimSortMerger
+{
+private:
+    /// A sorted run: base[start .. start + length)
+    struct Run
+    {
+        std::ptrdiff_t start;
+        std::ptrdiff_t length;
+    };
+
+    RandomIt base;                         ///< Start of the range being sorted
+    Less less;                             ///< Projected comparison
+    Buffer &buffer;                        ///< Scratch space, at most half the range
+    std::ptrdiff_t minGallop;              ///< Adaptive threshold for entering galloping mode
+    Run runs[TIMSORT_MAX_RUNS];            ///< Pending runs, oldest first; a fixed array, so merging never allocates
+    std::size_t runCount;                  ///< Number of pending runs
+
+    /**
+     * @brief Merges base[lo1 .. lo1 + len1) with the following len2 elements; len1 <= len2
+     */
+    void mergeLow(std::ptrdiff_t lo1, std::ptrdiff_t len1, std::ptrdiff_t lo2, std::ptrdiff_t len2)
+    {
+        buffer.clear();
+        buffer.insert(buffer.end(), std::make_move_iterator(base + lo1), std::make_move_iterator(base + (lo1 + len1)));
+
+        auto tmp = buffer.begin();
+        std::ptrdiff_t cursor1 = 0;   // Into the buffer
+        std::ptrdiff_t cursor2 = lo2; // Into base
+        std::ptrdiff_t dest = lo1;    // Into base
+
+        base[dest++] = std::move(base[cursor2++]);
+        if (--len2 == 0)
+        {
+            std::move(tmp + cursor1, tmp + (cursor1 + len1), base + dest);
+            return;
+        }
+        if (len1 == 1)
+        {
+            std::move(base + cursor2, base + (cursor2 + len2), base + dest);
+            base[dest + len2] = std::move(tmp[cursor1]);
+            return;
+        }
+
+        std::ptrdiff_t gallop = minGallop;
+        bool done = false;
+        while (!done)
+        {
+            std::ptrdiff_t count1 = 0; // Consecutive wins by run 1
+            std::ptrdiff_t count2 = 0; // Consecutive wins by run 2
+
+            // One element at a time until one run wins gallop times in a row
+            do
+            {
+                if (less(base[cursor2], tmp[cursor1]))
+                {
+                    base[dest++] = std::move(base[cursor2++]);
+                    count2++;
+                    count1 = 0;
+                    if (--len2 == 0)
+                    {
+                        done = true;
+                    }
+                }
+                else
+                {
+                    base[dest++] = std::move(tmp[cursor1++]);
+                    count1++;
+                    count2 = 0;
+                    if (--len1 == 1)
+                    {
+                        done = true;
+                    }
+                }
+            } while (!done && (count1 | count2) < gallop);
+
+            // Galloping: find how far each run wins and move that block at once
+            while (!done)
+            {
+                count1 = gallopRight(base[cursor2], tmp + cursor1, len1, 0, less);
+                if (count1 != 0)
+                {
+                    std::move(tmp + cursor1, tmp + (cursor1 + count1), base + dest);
+                    dest += count1;
+                    cursor1 += count1;
+                    len1 -= count1;
+                    if (len1 <= 1)
+                    {
+                        done = true;
+                        break;
+                    }
+                }
+                base[dest++] = std::move(base[cursor2++]);
+                if (--len2 == 0)
+                {
+                    done = true;
+                    break;
+                }
+
+                count2 = gallopLeft(tmp[cursor1], base + cursor2, len2, 0, less);
+                if (count2 != 0)
+                {
+                    std::move(base + cursor2, base + (cursor2 + count2), base + dest);
+                    dest += count2;
+                    cursor2 += count2;
+                    len2 -= count2;
+                    if (len2 == 0)
+                    {
+                        done = true;
+                        break;
+                    }
+                }
+                base[dest++] = std::move(tmp[cursor1++]);
+                if (--len1 == 1)
+                {
+                    done = true;
+                    break;
+                }
+
+                gallop--;
+                if (count1 < TIMSORT_MIN_GALLOP && count2 < TIMSORT_MIN_GALLOP)
+                {
+                    break;
+                }
+            }
+            if (!done)
+            {
+                // Galloping stopped paying off: make it harder to re-enter
+                gallop = std::max<std::ptrdiff_t>(gallop, 0) + 2;
+            }
+        }
+        minGallop = std::max<std::ptrdiff_t>(gallop, 1);
+
+        if (len1 == 1)
+        {
+            std::move(base + cursor2, base + (cursor2 + len2), base + dest);
+            base[dest + len2] = std::move(tmp[cursor1]);
+        }
+        else
+        {
+            // Run 2 is exhausted; the rest of run 1 goes last
+            std::move(tmp + cursor1, tmp + (cursor1 + len1), base + dest);
+        }
+    }
+
+    /**
+     * @brief Merges base[lo1 .. lo1 + len1) with the following len2 elements; len1 >= len2
+     *
+     * Mirror image of mergeLow, merging from the right end backwards.
+     */
+    void mergeHigh(std::ptrdiff_t lo1, std::ptrdiff_t len1, std::ptrdiff_t lo2, std::ptrdiff_t len2)
+    {
+        buffer.clear();
+        buffer.insert(buffer.end(), std::make_move_iterator(base + lo2), std::make_move_iterator(base + (lo2 + len2)));
+
+        auto tmp = buffer.begin();
+        std::ptrdiff_t cursor1 = lo1 + len1 - 1; // Into base
+        std::ptrdiff_t cursor2 = len2 - 1;       // Into the buffer
+        std::ptrdiff_t dest = lo2 + len2 - 1;    // Into base
+
+        base[dest--] = std::move(base[cursor1--]);
+        if (--len1 == 0)
+        {
+            std::move(tmp, tmp + len2, base + (dest - (len2 - 1)));
+            return;
+        }
+        if (len2 == 1)
+        {
+            dest -= len1;
+            cursor1 -= len1;
+            std::move_backward(base + (cursor1 + 1), base + (cursor1 + 1 + len1), base + (dest + 1 + len1));
+            base[dest] = std::move(tmp[cursor2]);
+            return;
+        }
+
+        std::ptrdiff_t gallop = minGallop;
+        bool done = false;
+        while (!done)
+        {
+            std::ptrdiff_t count1 = 0;
+            std::ptrdiff_t count2 = 0;
+
+            do
+            {
+                if (less(tmp[cursor2], base[cursor1]))
+                {
+                    base[dest--] = std::move(base[cursor1--]);
+                    count1++;
+                    count2 = 0;
+                    if (--len1 == 0)
+                    {
+                        done = true;
+                    }
+                }
+                else
+                {
+                    base[dest--] = std::move(tmp[cursor2--]);
+                    count2++;
+                    count1 = 0;
+                    if (--len2 == 1)
+                    {
+                        done = true;
+                    }
+                }
+            } while (!done && (count1 | count2) < gallop);
+
+            while (!done)
+            {
+                count1 = len1 - gallopRight(tmp[cursor2], base + lo1, len1, len1 - 1, less);
+                if (count1 != 0)
+                {
+                    dest -= count1;
+                    cursor1 -= count1;
+                    len1 -= count1;
+                    std::move_backward(base + (cursor1 + 1), base + (cursor1 + 1 + count1), base + (dest + 1 + count1));
+                    if (len1 == 0)
+                    {
+                        done = true;
+                        break;
+                    }
+                }
+                base[dest--] = std::move(tmp[cursor2--]);
+                if (--len2 == 1)
+                {
+                    done = true;
+                    break;
+                }
+
+                count2 = len2 - gallopLeft(base[cursor1], tmp, len2, len2 - 1, less);
+                if (count2 != 0)
+                {
+                    dest -= count2;
+                    cursor2 -= count2;
+                    len2 -= count2;
+                    std::move(tmp + (cursor2 + 1), tmp + (cursor2 + 1 + count2), base + (dest + 1));
+                    if (len2 <= 1)
+                    {
+                        done = true;
+                        break;
+                    }
+                }
+                base[dest--] = std::move(base[cursor1--]);
+                if (--len1 == 0)
+                {
+                    done = true;
+                    break;
+                }
+
+                gallop--;
+                if (count1 < TIMSORT_MIN_GALLOP && count2 < TIMSORT_MIN_GALLOP)
+                {
+                    break;
+                }
+            }
+            if (!done)
+            {
+                gallop = std::max<std::ptrdiff_t>(gallop, 0) + 2;
+            }
+        }
+        minGallop = std::max<std::ptrdiff_t>(gallop, 1);
+
+        if (len2 == 1)
+        {
+            dest -= len1;
+            cursor1 -= len1;
+            std::move_backward(base + (cursor1 + 1), base + (cursor1 + 1 + len1), base + (dest + 1 + len1));
+            base[dest] = std::move(tmp[cursor2]);
+        }
+        else
+        {
+            // Run 1 is exhausted; the rest of run 2 goes first
+            std::move(tmp, tmp + len2, base + (dest - (len2 - 1)));
+        }
+    }
+
+    /**
+     * @brief Merges runs i and i + 1 of the stack
+     */
+    void mergeAt(std::size_t i)
+    {
+        std::ptrdiff_t lo1 = runs[i].start;
+        std::ptrdiff_t len1 = runs[i].length;
+        std::ptrdiff_t lo2 = runs[i + 1].start;
+        std::ptrdiff_t len2 = runs[i + 1].length;
+
+        runs[i].length = len1 + len2;
+        if (i + 2 < runCount)
+        {
+            runs[i + 1] = runs[i + 2]; // Only the top three runs are ever merged
+        }
+        runCount--;
+
+        // Elements of run 1 not greater than run 2's first are already in place
+        std::ptrdiff_t k = gallopRight(base[lo2], base + lo1, len1, 0, less);
+        lo1 += k;
+        len1 -= k;
+        if (len1 == 0)
+        {
+            return;
+        }
+
+        // Elements of run 2 not less than run 1's last are already in place
+        len2 = gallopLeft(base[lo1 + len1 - 1], base + lo2, len2, len2 - 1, less);
+        if (len2 == 0)
+        {
+            return;
+        }
+
+        if (len1 <= len2)
+        {
+            mergeLow(lo1, len1, lo2, len2);
+        }
+        else
+        {
+            mergeHigh(lo1, len1, lo2, len2);
+        }
+    }
+
+public:
+    TimSortMerger(RandomIt first, Less lessThan, Buffer &scratch)
+        : base(first), less(lessThan), buffer(scratch), minGallop(TIMSORT_MIN_GALLOP), runCount(0)
+    {
+    }
+
+    /**
+     * @brief Pushes a sorted run onto the stack
+     *
+     * mergeCollapse keeps the run lengths growing like the Fibonacci
+     * numbers, so TIMSORT_MAX_RUNS runs cannot be pending at once.
+     */
+    void pushRun(std::ptrdiff_t start, std::ptrdiff_t length)
+    {
+        runs[runCount++] = {start, length};
+    }
+
+    /**
+     * @brief Merges runs until the stack invariants hold again
+     *
+     * Invariants, for the top runs X, Y, Z (Z on top) and the run W below X:
+     * len(X) > len(Y) + len(Z), len(W) > len(X) + len(Y), and len(Y) > len(Z).
+     */
+    void mergeCollapse()
+    {
+        while (runCount > 1)
+        {
+            std::size_t n = runCount - 2;
+            if ((n > 0 && runs[n - 1].length <= runs[n].length + runs[n + 1].length) ||
+                (n > 1 && runs[n - 2].length <= runs[n - 1].length + runs[n].length))
+            {
+                if (runs[n - 1].length < runs[n + 1].length)
+                {
+                    n--;
+                }
+            }
+            else if (runs[n].length > runs[n + 1].length)
+            {
+                break;
+            }
+            mergeAt(n);
+        }
+    }
+
+    /**
+     * @brief Merges every remaining run, finishing the sort
+     */
+    void mergeForceCollapse()
+    {
+        while (runCount > 1)
+        {
+            std::size_t n = runCount - 2;
+            if (n > 0 && runs[n - 1].length < runs[n + 1].length)
+            {
+                n--;
+            }
+            mergeAt(n);
+        }
+    }
+};
+
+/**
+ * @brief timSort on [first, last) with a scratch buffer
+ */
+template <typename RandomIt, typename Less, typename Buffer>
+void timSortRange(RandomIt first, RandomIt last, Less less, Buffer &buffer)
+{
+    std::ptrdiff_t n = last - first;
+    if (n < 2)
+    {
+        return;
+    }
+
+    // Small ranges: one run extended by binary insertion sort, no merging
+    if (n < TIMSORT_MIN_MERGE)
+    {
+        std::ptrdiff_t runLength = countRunAndMakeAscending(first, last, less);
+        binaryInsertionSort(first, last, first + runLength, less);
+        return;
+    }
+
+    TimSortMerger<RandomIt, Less, Buffer> merger(first, less, buffer);
+    std::ptrdiff_t minRun = timSortMinRun(n);
+    std::ptrdiff_t lo = 0;
+
+    while (lo < n)
+    {
+        // Take the next natural run, extending short ones to minRun elements
+        std::ptrdiff_t runLength = countRunAndMakeAscending(first + lo, last, less);
+        if (runLength < minRun)
+        {
+            std::ptrdiff_t forced = std::min(minRun, n - lo);
+            binaryInsertionSort(first + lo, first + (lo + forced), first + (lo + runLength), less);
+            runLength = forced;
+        }
+
+        merger.pushRun(lo, runLength);
+        merger.mergeCollapse();
+        lo += runLength;
+    }
+    merger.mergeForceCollapse();
+}
+
+} // namespace detail
+
+/**
+ * @brief Sorts a range with bubble sort, stopping early once no swap occurs
+ *
+ * @note Time Complexity: O(n^2) in worst and average cases, O(n) in best case.
+ * @note Stable.
+ */
+template <typename RandomIt, typename Compare = std::less<>, typename Projection = Identity>
+void bubbleSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    auto less = detail::projectedLess(comp, proj);
+    for (RandomIt end = last; end - first > 1; --end)
+    {
+        bool swapped = false;
+        for (RandomIt j = first; j + 1 != end; ++j)
+        {
+            if (less(*(j + 1), *j))
+            {
+                std::iter_swap(j, j + 1);
+                swapped = true;
+            }
+        }
+        if (!swapped)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Sorts a range with insertion sort
+ *
+ * @note Time Complexity: O(n^2) in worst case, O(n) on sorted input.
+ * @note Stable.
+ */
+template <typename RandomIt, typename Compare = std::less<>, typename Projection = Identity>
+void insertionSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    detail::insertionSortRange(first, last, detail::projectedLess(comp, proj));
+}
+
+/**
+ * @brief Sorts a range with selection sort
+ *
+ * @note Time Complexity: O(n^2), with at most n - 1 swaps.
+ */
+template <typename RandomIt, typename Compare = std::less<>, typename Projection = Identity>
+void selectionSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    auto less = detail::projectedLess(comp, proj);
+    for (RandomIt i = first; last - i > 1; ++i)
+    {
+        RandomIt minIt = i;
+        for (RandomIt j = i + 1; j != last; ++j)
+        {
+            if (less(*j, *minIt))
+            {
+                minIt = j;
+            }
+        }
+        std::iter_swap(i, minIt);
+    }
+}
+
+/**
+ * @brief Sorts a range with heap sort
+ *
+ * @note Time Complexity: O(n log n) in all cases, O(1) extra space.
+ */
+template <typename RandomIt, typename Compare = std::less<>, typename Projection = Identity>
+void heapSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    detail::heapSortRange(first, last, detail::projectedLess(comp, proj));
+}
+
+/**
+ * @brief Sorts a range with the classic recursive quicksort
+ *
+ * The pivot is the last element, as in quick_sort.cpp, so sorted and
+ * duplicate-heavy input is quadratic; prefer introSort for production use.
+ *
+ * @param scheme The partition kernel to use
+ */
+template <typename RandomIt, typename Compare = std::less<>, typename Projection = Identity>
+void quickSort(RandomIt first, RandomIt last, PartitionScheme scheme = PartitionScheme::Lomuto,
+               Compare comp = Compare(), Projection proj = Projection())
+{
+    detail::quickSortRange(first, last, scheme, detail::projectedLess(comp, proj));
+}
+
+/**
+ * @brief Sorts a range with introsort
+ *
+ * Median-of-three/ninther pivots, three-way partitioning, insertion sort for
+ * small subranges and a heap sort fallback at depth 2*log2(n).
+ *
+ * @note Time Complexity: O(n log n) in the worst case, O(log n) stack.
+ */
+template <typename RandomIt, typename Compare = std::less<>, typename Projection = Identity>
+void introSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    detail::introSortLoop(first, last, detail::introSortDepthLimit(last - first), detail::projectedLess(comp, proj));
+}
+
+/**
+ * @brief Sorts a range with timSort, a stable natural merge sort
+ *
+ * Finds the ascending and strictly descending runs already present in the
+ * input, extends short ones to a computed minimum run length with binary
+ * insertion sort, and merges them with galloping merges that move whole
+ * blocks when one run keeps winning. A mostly sorted input with an
+ * appended tail costs little more than one pass.
+ *
+ * @param buffer Optional scratch space reused across calls to avoid
+ *        allocation; it grows to at most half the range and keeps its capacity
+ *
+ * @note Time Complexity: O(n) on sorted input, O(n log n) in the worst case.
+ * @note Space Complexity: O(n / 2) scratch.
+ * @note Stable.
+ */
+template <typename RandomIt, typename Compare = std::less<>, typename Projection = Identity>
+void timSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection(),
+             std::vector<typename std::iterator_traits<RandomIt>::value_type> *buffer = nullptr)
+{
+    std::vector<typename std::iterator_traits<RandomIt>::value_type> localBuffer;
+    detail::timSortRange(first, last, detail::projectedLess(comp, proj), buffer ? *buffer : localBuffer);
+}
+
+/**
+ * @brief Sorts a range by an integral key with stable LSD radix sort
+ *
+ * The projection must return an integral type of at most 64 bits; signed
+ * keys are ordered correctly. Uses 8-bit digits, one scratch buffer of
+ * value_type (which must be default constructible), and skips passes whose
+ * digit is the same for every key.
+ *
+ * @note Time Complexity: O(n * sizeof(key)).
+ * @note Stable.
+ */
+template <typename RandomIt, typename Projection = Identity>
+void radixSort(RandomIt first, RandomIt last, Projection proj = Projection())
+{
+    using Value = typename std::iterator_traits<RandomIt>::value_type;
+    using Key = std::decay_t<std::invoke_result_t<Projection &, const Value &>>;
+    static_assert(std::is_integral<Key>::value, "radixSort requires an integral key");
+    using UnsignedKey = std::make_unsigned_t<Key>;
+
+    const int passes = (int)sizeof(Key);
+    const std::size_t n = (std::size_t)(last - first);
+    if (n < 2)
+    {
+        return;
+    }
+
+    auto digitOf = [&proj](const Value &value, int shift) -> std::size_t
+    {
+        UnsignedKey key = (UnsignedKey)std::invoke(proj, value);
+        if constexpr (std::is_signed<Key>::value)
+        {
+            key ^= (UnsignedKey)((UnsignedKey)1 << (8 * sizeof(Key) - 1));
+        }
+        return (std::size_t)((key >> shift) & 0xFF);
+    };
+
+    std::vector<std::size_t> counts(passes * 256, 0);
+    for (RandomIt it = first; it != last; ++it)
+    {
+        for (int d = 0; d < passes; d++)
+        {
+            counts[d * 256 + digitOf(*it, 8 * d)]++;
+        }
+    }
+
+    std::vector<Value> buffer(n);
+    bool inBuffer = false;
+
+    // Stable scatter of src[0..n) into dst by the digit at shift
+    auto scatter = [&](auto src, auto dst, int shift, std::size_t *offsets)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            std::size_t digit = digitOf(src[i], shift);
+            dst[offsets[digit]++] = std::move(src[i]);
+        }
+    };
+
+    for (int d = 0; d < passes; d++)
+    {
+        std::size_t *count = &counts[d * 256];
+        const Value &firstValue = inBuffer ? buffer[0] : *first;
+        if (count[digitOf(firstValue, 8 * d)] == n)
+        {
+            continue; // Every key has the same digit here
+        }
+
+        std::size_t offsets[256];
+        std::size_t sum = 0;
+        for (int b = 0; b < 256; b++)
+        {
+            offsets[b] = sum;
+            sum += count[b];
+        }
+
+        if (inBuffer)
+        {
+            scatter(buffer.begin(), first, 8 * d, offsets);
+        }
+        else
+        {
+            scatter(first, buffer.begin(), 8 * d, offsets);
+        }
+        inBuffer = !inBuffer;
+    }
+
+    if (inBuffer)
+    {
+        std::move(buffer.begin(), buffer.end(), first);
+    }
+}
+
+/**
+ * @brief Checks whether a range is sorted
+ * @return true if no element compares less than its predecessor
+ */
+template <typename RandomIt, typename Compare = std::less<>, typename Projection = Identity>
+bool isSorted(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection())
+{
+    auto less = detail::projectedLess(comp, proj);
+    for (RandomIt it = first; it != last && it + 1 != last; ++it)
+    {
+        if (less(*(it + 1), *it))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace sorting
+
+#endif // GENERIC_SORT_H
@@ -0,0 +1,139 @@
+/**
+ * @file generic_sort_demo.cpp
+ * @brief Demonstration of the templated sorts in generic_sort.h
+ *
+ * This program sorts a vector of records by different fields with
+ * comparators and projections, sorts doubles and strings, and checks every
+ * algorithm in the library against std::sort on random input.
+ */
+
+#include "generic_sort.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @struct Employee
+ * @brief A sample record sorted by one of its fields
+ */
+struct Employee
+{
+    string name;   ///< The employee's name
+    int age;       ///< The employee's age in years
+    double salary; ///< The employee's yearly salary
+};
+
+/**
+ * @brief Prints a list of employees
+ * @param employees The employees to be printed
+ */
+void printEmployees(const vector<Employee> &employees)
+{
+    for (const Employee &e : employees)
+    {
+        cout << "  " << e.name << " (age " << e.age << ", salary " << e.salary << ")" << endl;
+    }
+}
+
+/**
+ * @brief Main function to demonstrate the templated sorts
+ * @return 0 if every algorithm sorted the random input correctly, 1 otherwise
+ */
+int main()
+{
+    vector<Employee> staff = {
+        {"Asha", 34, 72000.0},
+        {"Bilal", 28, 58000.0},
+        {"Chen", 45, 91000.0},
+        {"Dana", 28, 61000.0},
+        {"Eitan", 39, 58000.0},
+    };
+
+    // Sort records by a field: the projection extracts the key, no int array needed
+    sorting::introSort(staff.begin(), staff.end(), less<>(), &Employee::age);
+    cout << "Sorted by age:" << endl;
+    printEmployees(staff);
+
+    // Descending order with a different comparator and key
+    sorting::insertionSort(staff.begin(), staff.end(), greater<>(), &Employee::salary);
+    cout << "Sorted by salary, highest first:" << endl;
+    printEmployees(staff);
+
+    // Projection returning a computed key
+    sorting::selectionSort(staff.begin(), staff.end(), less<>(), [](const Employee &e) { return e.name.size(); });
+    cout << "Sorted by name length:" << endl;
+    printEmployees(staff);
+
+    // Radix sort is stable: employees of the same age keep their previous relative order
+    sorting::radixSort(staff.begin(), staff.end(), &Employee::age);
+    cout << "Radix sorted by age:" << endl;
+    printEmployees(staff);
+
+    // Plain arrays work through pointers
+    double values[] = {3.5, -1.25, 2.0, 9.75, 0.5};
+    sorting::heapSort(values, values + 5);
+    cout << "Sorted doubles: ";
+    for (double v : values)
+    {
+        cout << v << " ";
+    }
+    cout << endl;
+
+    vector<string> words = {"pear", "apple", "fig", "banana", "cherry"};
+    sorting::bubbleSort(words.begin(), words.end());
+    cout << "Sorted strings: ";
+    for (const string &w : words)
+    {
+        cout << w << " ";
+    }
+    cout << endl;
+
+    // Check every algorithm against std::sort on random input with duplicates
+    mt19937 generator(99);
+    vector<long long> input(3000);
+    for (long long &x : input)
+    {
+        x = (long long)(generator() % 1000) - 500;
+    }
+    vector<long long> expected(input);
+    sort(expected.begin(), expected.end());
+
+    bool allCorrect = true;
+    auto check = [&](const char *name, void (*sortFunction)(vector<long long> &))
+    {
+        vector<long long> arr(input);
+        sortFunction(arr);
+        bool correct = arr == expected;
+        allCorrect = allCorrect && correct;
+        cout << name << ": " << (correct ? "correct" : "WRONG") << endl;
+    };
+
+    cout << endl << "Checking against std::sort on " << input.size() << " random values" << endl;
+    check("bubbleSort", [](vector<long long> &a) { sorting::bubbleSort(a.begin(), a.end()); });
+    check("insertionSort", [](vector<long long> &a) { sorting::insertionSort(a.begin(), a.end()); });
+    check("selectionSort", [](vector<long long> &a) { sorting::selectionSort(a.begin(), a.end()); });
+    check("heapSort", [](vector<long long> &a) { sorting::heapSort(a.begin(), a.end()); });
+    check("quickSort (Lomuto)", [](vector<long long> &a) { sorting::quickSort(a.begin(), a.end()); });
+    check("quickSort (block)",
+          [](vector<long long> &a) { sorting::quickSort(a.begin(), a.end(), sorting::PartitionScheme::Block); });
+    check("introSort", [](vector<long long> &a) { sorting::introSort(a.begin(), a.end()); });
+    check("timSort", [](vector<long long> &a) { sorting::timSort(a.begin(), a.end()); });
+    check("radixSort", [](vector<long long> &a) { sorting::radixSort(a.begin(), a.end()); });
+
+    return allCorrect ? 0 : 1;
+}
+
+/**
+ * Usage Instructions:
+ * 1. Compile the program with C++17 (e.g., g++ -std=c++17 -O2 generic_sort_demo.cpp -o generic_sort_demo)
+ * 2. Run the compiled executable (e.g., ./generic_sort_demo)
+ *
+ * To use the library in your own code:
+ * 1. #include "generic_sort.h"
+ * 2. Call any sort with an iterator range, and optionally a comparator and a projection
+ *    Example: sorting::introSort(records.begin(), records.end(), std::less<>(), &Record::id);
+ */
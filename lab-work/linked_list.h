@@ -0,0 +1,1038 @@
+/**
+ * @file linked_list.h
+ * @brief Header-only generic singly and doubly linked lists
+ *
+ * The linked list files in lab-work are free functions over a raw Node
+ * pointer that hold one int each, and nothing frees their nodes. This
+ * header gathers their operations into two class templates:
+ *
+ * - SinglyList<T, Alloc> with forward iterators
+ * - DoublyList<T, Alloc> with bidirectional iterators
+ *
+ * Each list owns its nodes and frees them when it is destroyed. A list can
+ * be moved but not copied. Elements are constructed in their nodes by the
+ * emplace functions, so a record is never copied into the list, and splice
+ * relinks nodes from one list into another without copying or allocating.
+ *
+ * Alloc is NodePool (the default) or HeapNodeAllocator from node_pool.h.
+ * Both lists keep their length and a tail pointer, so appending and
+ * countNodes take O(1). The operations that take a value find its first
+ * occurrence with operator==.
+ *
+ * Requires C++17.
+ */
+
+#ifndef LINKED_LIST_H
+#define LINKED_LIST_H
+
+#include "node_pool.h"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace list_detail
+{
+
+/**
+ * @brief Constructs a list element from args: with parentheses if T has a
+ *        matching constructor, otherwise with braces, so aggregates work too
+ */
+template <typename T, typename... Args>
+constexpr bool USE_PARENTHESES = std::is_constructible<T, Args &&...>::value;
+
+} // namespace list_detail
+
+/**
+ * @class SinglyList
+ * @brief A singly linked list that owns its elements
+ *
+ * @tparam T The element type
+ * @tparam Alloc The node allocator template: NodePool or HeapNodeAllocator
+ */
+template <typename T, template <typename> class Alloc = NodePool>
+class SinglyList
+{
+private:
+    /**
+     * @struct Node
+     * @brief Represents a node of the list, holding one element
+     */
+    struct Node
+    {
+        Node *next; ///< Pointer to the next node in the list
+        T data;     ///< The element stored in the node
+
+        /**
+         * @brief Construct a node, forwarding args to the constructor of the element
+         */
+        template <typename... Args, std::enable_if_t<list_detail::USE_PARENTHESES<T, Args...>, int> = 0>
+        Node(Node *nextNode, Args &&...args) : next(nextNode), data(std::forward<Args>(args)...)
+        {
+        }
+
+        /**
+         * @brief Construct a node, aggregate-initializing the element from args
+         */
+        template <typename... Args, std::enable_if_t<!list_detail::USE_PARENTHESES<T, Args...>, int> = 0>
+        Node(Node *nextNode, Args &&...args) : next(nextNode), data{std::forward<Args>(args)...}
+        {
+        }
+    };
+
+    Node *head;         ///< Pointer to the first node in the list
+    Node *tail;         ///< Pointer to the last node in the list
+    std::size_t size;   ///< Number of elements in the list
+    Alloc<Node> nodes;  ///< Allocates and frees the nodes of this list
+
+    /**
+     * @class Iterator
+     * @brief A forward iterator over the elements; IsConst selects const_iterator
+     */
+    template <bool IsConst>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T *, T *>;
+        using reference = std::conditional_t<IsConst, const T &, T &>;
+
+        Iterator() : node(nullptr) {}
+
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &node->data; }
+
+        Iterator &operator++()
+        {
+            node = node->next;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator old = *this;
+            node = node->next;
+            return old;
+        }
+
+        /**
+         * @brief Converts an iterator to a const_iterator
+         */
+        template <bool C = IsConst, std::enable_if_t<!C, int> = 0>
+        operator Iterator<true>() const
+        {
+            return Iterator<true>(node);
+        }
+
+        friend bool operator==(const Iterator &a, const Iterator &b) { return a.node == b.node; }
+        friend bool operator!=(const Iterator &a, const Iterator &b) { return a.node != b.node; }
+
+    private:
+        Node *node; ///< The current node, or nullptr at the end
+
+        explicit Iterator(Node *current) : node(current) {}
+
+        friend class Iterator<!IsConst>;
+        friend class SinglyList;
+    };
+
+    /**
+     * @brief Links a new node after prev, or at the front if prev is nullptr
+     * @return The new node
+     */
+    template <typename... Args>
+    Node *linkAfter(Node *prev, Args &&...args)
+    {
+        Node *next = prev == nullptr ? head : prev->next;
+        Node *node = nodes.create(next, std::forward<Args>(args)...);
+        (prev == nullptr ? head : prev->next) = node;
+        if (next == nullptr)
+        {
+            tail = node;
+        }
+        size++;
+        return node;
+    }
+
+    /**
+     * @brief Unlinks and destroys the node after prev, or the head if prev is nullptr
+     */
+    void unlinkAfter(Node *prev)
+    {
+        Node *node = prev == nullptr ? head : prev->next;
+        (prev == nullptr ? head : prev->next) = node->next;
+        if (node == tail)
+        {
+            tail = prev;
+        }
+        size--;
+        nodes.destroy(node);
+    }
+
+    /**
+     * @brief Finds the first node holding value and the node before it
+     * @param value The value to search for
+     * @param prev Set to the node before the one found, or nullptr if it is the head
+     * @return The node holding value, or nullptr if there is none
+     */
+    Node *findWithPrev(const T &value, Node *&prev) const
+    {
+        prev = nullptr;
+        for (Node *node = head; node != nullptr; prev = node, node = node->next)
+        {
+            if (node->data == value)
+            {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+public:
+    using value_type = T;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    /**
+     * @brief Construct an empty list
+     */
+    SinglyList() : head(nullptr), tail(nullptr), size(0) {}
+
+    /**
+     * @brief Destroy the list and every element in it
+     */
+    ~SinglyList()
+    {
+        clear();
+    }
+
+    SinglyList(const SinglyList &) = delete;
+    SinglyList &operator=(const SinglyList &) = delete;
+
+    /**
+     * @brief Take over the nodes of another list, leaving it empty
+     */
+    SinglyList(SinglyList &&other) noexcept
+        : head(other.head), tail(other.tail), size(other.size), nodes(std::move(other.nodes))
+    {
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+
+    /**
+     * @brief Destroy this list's elements and take over the nodes of another list
+     */
+    SinglyList &operator=(SinglyList &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            std::swap(head, other.head);
+            std::swap(tail, other.tail);
+            std::swap(size, other.size);
+            std::swap(nodes, other.nodes);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Constructs an element at the beginning of the list
+     * @param args The arguments of the element's constructor
+     * @return Reference to the new element
+     */
+    template <typename... Args>
+    T &emplaceFirst(Args &&...args)
+    {
+        return linkAfter(nullptr, std::forward<Args>(args)...)->data;
+    }
+
+    /**
+     * @brief Constructs an element at the end of the list, in O(1)
+     * @param args The arguments of the element's constructor
+     * @return Reference to the new element
+     */
+    template <typename... Args>
+    T &emplaceLast(Args &&...args)
+    {
+        return linkAfter(tail, std::forward<Args>(args)...)->data;
+    }
+
+    /**
+     * @brief Constructs an element after the one at pos
+     * @param pos An iterator to an element of this list, not end()
+     * @param args The arguments of the element's constructor
+     * @return Iterator to the new element
+     */
+    template <typename... Args>
+    iterator emplaceAfter(const_iterator pos, Args &&...args)
+    {
+        return iterator(linkAfter(pos.node, std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Inserts a value at the beginning of the list
+     */
+    void insertFirst(T value)
+    {
+        emplaceFirst(std::move(value));
+    }
+
+    /**
+     * @brief Inserts a value at the end of the list, in O(1)
+     */
+    void insertLast(T value)
+    {
+        emplaceLast(std::move(value));
+    }
+
+    /**
+     * @brief Inserts a value after the first occurrence of another
+     * @param specificValue The value to search for in the list
+     * @param newValue The value to be inserted
+     * @return true if specificValue was found and newValue inserted, false otherwise
+     */
+    bool insertAfter(const T &specificValue, T newValue)
+    {
+        Node *prev;
+        Node *node = findWithPrev(specificValue, prev);
+        if (node == nullptr)
+        {
+            return false;
+        }
+        linkAfter(node, std::move(newValue));
+        return true;
+    }
+
+    /**
+     * @brief Inserts a value before the first occurrence of another
+     * @param specificValue The value to search for in the list
+     * @param newValue The value to be inserted
+     * @return true if specificValue was found and newValue inserted, false otherwise
+     */
+    bool insertBefore(const T &specificValue, T newValue)
+    {
+        Node *prev;
+        if (findWithPrev(specificValue, prev) == nullptr)
+        {
+            return false;
+        }
+        linkAfter(prev, std::move(newValue));
+        return true;
+    }
+
+    /**
+     * @brief Searches for a value in the list
+     * @return true if the value is found, false otherwise
+     */
+    bool search(const T &value) const
+    {
+        Node *prev;
+        return findWithPrev(value, prev) != nullptr;
+    }
+
+    /**
+     * @brief Returns an iterator to the first occurrence of value, or end()
+     */
+    iterator find(const T &value)
+    {
+        Node *prev;
+        return iterator(findWithPrev(value, prev));
+    }
+
+    /**
+     * @brief Returns a const_iterator to the first occurrence of value, or end()
+     */
+    const_iterator find(const T &value) const
+    {
+        Node *prev;
+        return const_iterator(findWithPrev(value, prev));
+    }
+
+    /**
+     * @brief Deletes the first element of the list
+     * @return true if an element was deleted, false if the list is empty
+     */
+    bool deleteFirst()
+    {
+        if (head == nullptr)
+        {
+            return false;
+        }
+        unlinkAfter(nullptr);
+        return true;
+    }
+
+    /**
+     * @brief Deletes the last element of the list
+     * @return true if an element was deleted, false if the list is empty
+     *
+     * @note O(n): the node before the tail can only be found from the head.
+     */
+    bool deleteLast()
+    {
+        if (head == nullptr)
+        {
+            return false;
+        }
+        Node *prev = nullptr;
+        for (Node *node = head; node != tail; node = node->next)
+        {
+            prev = node;
+        }
+        unlinkAfter(prev);
+        return true;
+    }
+
+    /**
+     * @brief Deletes the first occurrence of a value
+     * @return true if the value was found and deleted, false otherwise
+     */
+    bool deleteSpecific(const T &value)
+    {
+        Node *prev;
+        if (findWithPrev(value, prev) == nullptr)
+        {
+            return false;
+        }
+        unlinkAfter(prev);
+        return true;
+    }
+
+    /**
+     * @brief Deletes the element after the one at pos
+     * @param pos An iterator to an element of this list that is not the last
+     * @return Iterator to the element after the deleted one
+     */
+    iterator eraseAfter(const_iterator pos)
+    {
+        unlinkAfter(pos.node);
+        return iterator(pos.node->next);
+    }
+
+    /**
+     * @brief Deletes every element
+     *
+     * A NodePool of trivially destructible elements is released at once;
+     * otherwise each node is destroyed.
+     */
+    void clear()
+    {
+        if constexpr (Alloc<Node>::RELEASES_ALL && std::is_trivially_destructible<T>::value)
+        {
+            nodes.releaseAll();
+        }
+        else
+        {
+            while (head != nullptr)
+            {
+                Node *next = head->next;
+                nodes.destroy(head);
+                head = next;
+            }
+        }
+        head = tail = nullptr;
+        size = 0;
+    }
+
+    /**
+     * @brief Moves every element of other to the beginning of this list, in O(1)
+     *
+     * The nodes are relinked, not copied; other is left empty.
+     */
+    void spliceFirst(SinglyList &other)
+    {
+        if (this == &other || other.head == nullptr)
+        {
+            return;
+        }
+        nodes.adopt(other.nodes);
+        other.tail->next = head;
+        if (tail == nullptr)
+        {
+            tail = other.tail;
+        }
+        head = other.head;
+        size += other.size;
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+
+    /**
+     * @brief Moves every element of other to the end of this list, in O(1)
+     *
+     * The nodes are relinked, not copied; other is left empty.
+     */
+    void spliceLast(SinglyList &other)
+    {
+        if (this == &other || other.head == nullptr)
+        {
+            return;
+        }
+        nodes.adopt(other.nodes);
+        (tail == nullptr ? head : tail->next) = other.head;
+        tail = other.tail;
+        size += other.size;
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+
+    /**
+     * @brief Returns the number of elements in the list, in O(1)
+     */
+    std::size_t countNodes() const
+    {
+        return size;
+    }
+
+    /**
+     * @brief Returns true if the list has no elements
+     */
+    bool empty() const
+    {
+        return size == 0;
+    }
+
+    T &front() { return head->data; }
+    const T &front() const { return head->data; }
+    T &back() { return tail->data; }
+    const T &back() const { return tail->data; }
+
+    iterator begin() { return iterator(head); }
+    iterator end() { return iterator(nullptr); }
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(nullptr); }
+};
+
+/**
+ * @class DoublyList
+ * @brief A doubly linked list that owns its elements
+ *
+ * @tparam T The element type
+ * @tparam Alloc The node allocator template: NodePool or HeapNodeAllocator
+ */
+template <typename T, template <typename> class Alloc = NodePool>
+class DoublyList
+{
+private:
+    /**
+     * @struct Node
+     * @brief Represents a node of the list, holding one element
+     */
+    struct Node
+    {
+        Node *prev; ///< Pointer to the previous node
+        Node *next; ///< Pointer to the next node
+        T data;     ///< The element stored in the node
+
+        /**
+         * @brief Construct a node, forwarding args to the constructor of the element
+         */
+        template <typename... Args, std::enable_if_t<list_detail::USE_PARENTHESES<T, Args...>, int> = 0>
+        Node(Node *prevNode, Node *nextNode, Args &&...args)
+            : prev(prevNode), next(nextNode), data(std::forward<Args>(args)...)
+        {
+        }
+
+        /**
+         * @brief Construct a node, aggregate-initializing the element from args
+         */
+        template <typename... Args, std::enable_if_t<!list_detail::USE_PARENTHESES<T, Args...>, int> = 0>
+        Node(Node *prevNode, Node *nextNode, Args &&...args)
+            : prev(prevNode), next(nextNode), data{std::forward<Args>(args)...}
+        {
+        }
+    };
+
+    Node *head;         ///< Pointer to the first node in the list
+    Node *tail;         ///< Pointer to the last node in the list
+    std::size_t size;   ///< Number of elements in the list
+    Alloc<Node> nodes;  ///< Allocates and frees the nodes of this list
+
+    /**
+     * @class Iterator
+     * @brief A bidirectional iterator over the elements; IsConst selects const_iterator
+     *
+     * Holds its list so that decrementing end() reaches the last element.
+     */
+    template <bool IsConst>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T *, T *>;
+        using reference = std::conditional_t<IsConst, const T &, T &>;
+
+        Iterator() : node(nullptr), list(nullptr) {}
+
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &node->data; }
+
+        Iterator &operator++()
+        {
+            node = node->next;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator old = *this;
+            node = node->next;
+            return old;
+        }
+
+        Iterator &operator--()
+        {
+            node = node == nullptr ? list->tail : node->prev;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        /**
+         * @brief Converts an iterator to a const_iterator
+         */
+        template <bool C = IsConst, std::enable_if_t<!C, int> = 0>
+        operator Iterator<true>() const
+        {
+            return Iterator<true>(node, list);
+        }
+
+        friend bool operator==(const Iterator &a, const Iterator &b) { return a.node == b.node; }
+        friend bool operator!=(const Iterator &a, const Iterator &b) { return a.node != b.node; }
+
+    private:
+        Node *node;             ///< The current node, or nullptr at the end
+        const DoublyList *list; ///< The list iterated over
+
+        Iterator(Node *current, const DoublyList *owner) : node(current), list(owner) {}
+
+        friend class Iterator<!IsConst>;
+        friend class DoublyList;
+    };
+
+    /**
+     * @brief Links a new node before next, or at the end if next is nullptr
+     * @return The new node
+     */
+    template <typename... Args>
+    Node *linkBefore(Node *next, Args &&...args)
+    {
+        Node *prev = next == nullptr ? tail : next->prev;
+        Node *node = nodes.create(prev, next, std::forward<Args>(args)...);
+        (prev == nullptr ? head : prev->next) = node;
+        (next == nullptr ? tail : next->prev) = node;
+        size++;
+        return node;
+    }
+
+    /**
+     * @brief Unlinks a chain of nodes from this list without destroying them
+     * @param first The first node of the chain
+     * @param last The last node of the chain
+     */
+    void unlinkChain(Node *first, Node *last)
+    {
+        (first->prev == nullptr ? head : first->prev->next) = last->next;
+        (last->next == nullptr ? tail : last->next->prev) = first->prev;
+    }
+
+    /**
+     * @brief Links a chain of nodes into this list before next, or at the end if next is nullptr
+     * @param next The node to link the chain before
+     * @param first The first node of the chain
+     * @param last The last node of the chain
+     */
+    void linkChain(Node *next, Node *first, Node *last)
+    {
+        Node *prev = next == nullptr ? tail : next->prev;
+        first->prev = prev;
+        last->next = next;
+        (prev == nullptr ? head : prev->next) = first;
+        (next == nullptr ? tail : next->prev) = last;
+    }
+
+    /**
+     * @brief Unlinks and destroys a node
+     * @return The node after it, or nullptr
+     */
+    Node *unlink(Node *node)
+    {
+        Node *next = node->next;
+        unlinkChain(node, node);
+        size--;
+        nodes.destroy(node);
+        return next;
+    }
+
+    /**
+     * @brief Finds the first node holding value, or nullptr
+     */
+    Node *findNode(const T &value) const
+    {
+        Node *node = head;
+        while (node != nullptr && !(node->data == value))
+        {
+            node = node->next;
+        }
+        return node;
+    }
+
+public:
+    using value_type = T;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief Construct an empty list
+     */
+    DoublyList() : head(nullptr), tail(nullptr), size(0) {}
+
+    /**
+     * @brief Destroy the list and every element in it
+     */
+    ~DoublyList()
+    {
+        clear();
+    }
+
+    DoublyList(const DoublyList &) = delete;
+    DoublyList &operator=(const DoublyList &) = delete;
+
+    /**
+     * @brief Take over the nodes of another list, leaving it empty
+     *
+     * Iterators into other stay valid but refer to the list they came from.
+     */
+    DoublyList(DoublyList &&other) noexcept
+        : head(other.head), tail(other.tail), size(other.size), nodes(std::move(other.nodes))
+    {
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+
+    /**
+     * @brief Destroy this list's elements and take over the nodes of another list
+     */
+    DoublyList &operator=(DoublyList &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            std::swap(head, other.head);
+            std::swap(tail, other.tail);
+            std::swap(size, other.size);
+            std::swap(nodes, other.nodes);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Constructs an element before the one at pos
+     * @param pos An iterator into this list; end() appends
+     * @param args The arguments of the element's constructor
+     * @return Iterator to the new element
+     */
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args)
+    {
+        return iterator(linkBefore(pos.node, std::forward<Args>(args)...), this);
+    }
+
+    /**
+     * @brief Constructs an element at the beginning of the list
+     * @return Reference to the new element
+     */
+    template <typename... Args>
+    T &emplaceFirst(Args &&...args)
+    {
+        return linkBefore(head, std::forward<Args>(args)...)->data;
+    }
+
+    /**
+     * @brief Constructs an element at the end of the list, in O(1)
+     * @return Reference to the new element
+     */
+    template <typename... Args>
+    T &emplaceLast(Args &&...args)
+    {
+        return linkBefore(nullptr, std::forward<Args>(args)...)->data;
+    }
+
+    /**
+     * @brief Inserts a value at the beginning of the list
+     */
+    void insertFirst(T value)
+    {
+        emplaceFirst(std::move(value));
+    }
+
+    /**
+     * @brief Inserts a value at the end of the list, in O(1)
+     */
+    void insertLast(T value)
+    {
+        emplaceLast(std::move(value));
+    }
+
+    /**
+     * @brief Inserts a value after the first occurrence of another
+     * @param specificValue The value to search for in the list
+     * @param newValue The value to be inserted
+     * @return true if specificValue was found and newValue inserted, false otherwise
+     */
+    bool insertAfter(const T &specificValue, T newValue)
+    {
+        Node *node = findNode(specificValue);
+        if (node == nullptr)
+        {
+            return false;
+        }
+        linkBefore(node->next, std::move(newValue));
+        return true;
+    }
+
+    /**
+     * @brief Inserts a value before the first occurrence of another
+     * @param specificValue The value to search for in the list
+     * @param newValue The value to be inserted
+     * @return true if specificValue was found and newValue inserted, false otherwise
+     */
+    bool insertBefore(const T &specificValue, T newValue)
+    {
+        Node *node = findNode(specificValue);
+        if (node == nullptr)
+        {
+            return false;
+        }
+        linkBefore(node, std::move(newValue));
+        return true;
+    }
+
+    /**
+     * @brief Searches for a value in the list
+     * @return true if the value is found, false otherwise
+     */
+    bool search(const T &value) const
+    {
+        return findNode(value) != nullptr;
+    }
+
+    /**
+     * @brief Returns an iterator to the first occurrence of value, or end()
+     */
+    iterator find(const T &value)
+    {
+        return iterator(findNode(value), this);
+    }
+
+    /**
+     * @brief Returns a const_iterator to the first occurrence of value, or end()
+     */
+    const_iterator find(const T &value) const
+    {
+        return const_iterator(findNode(value), this);
+    }
+
+    /**
+     * @brief Deletes the first element of the list
+     * @return true if an element was deleted, false if the list is empty
+     */
+    bool deleteFirst()
+    {
+        if (head == nullptr)
+        {
+            return false;
+        }
+        unlink(head);
+        return true;
+    }
+
+    /**
+     * @brief Deletes the last element of the list, in O(1)
+     * @return true if an element was deleted, false if the list is empty
+     */
+    bool deleteLast()
+    {
+        if (tail == nullptr)
+        {
+            return false;
+        }
+        unlink(tail);
+        return true;
+    }
+
+    /**
+     * @brief Deletes the first occurrence of a value
+     * @return true if the value was found and deleted, false otherwise
+     */
+    bool deleteSpecific(const T &value)
+    {
+        Node *node = findNode(value);
+        if (node == nullptr)
+        {
+            return false;
+        }
+        unlink(node);
+        return true;
+    }
+
+    /**
+     * @brief Deletes the element at pos
+     * @param pos An iterator to an element of this list, not end()
+     * @return Iterator to the element after the deleted one
+     */
+    iterator erase(const_iterator pos)
+    {
+        return iterator(unlink(pos.node), this);
+    }
+
+    /**
+     * @brief Deletes every element
+     *
+     * A NodePool of trivially destructible elements is released at once;
+     * otherwise each node is destroyed.
+     */
+    void clear()
+    {
+        if constexpr (Alloc<Node>::RELEASES_ALL && std::is_trivially_destructible<T>::value)
+        {
+            nodes.releaseAll();
+        }
+        else
+        {
+            while (head != nullptr)
+            {
+                Node *next = head->next;
+                nodes.destroy(head);
+                head = next;
+            }
+        }
+        head = tail = nullptr;
+        size = 0;
+    }
+
+    /**
+     * @brief Moves every element of other before pos, in O(1)
+     * @param pos An iterator into this list; end() appends
+     * @param other The list to take the elements from, left empty
+     *
+     * The nodes are relinked, not copied, and iterators to them stay valid.
+     */
+    void splice(const_iterator pos, DoublyList &other)
+    {
+        if (this == &other || other.head == nullptr)
+        {
+            return;
+        }
+        nodes.adopt(other.nodes);
+        linkChain(pos.node, other.head, other.tail);
+        size += other.size;
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+
+    /**
+     * @brief Moves the elements [first, last) of this list before pos, in O(1)
+     * @param pos An iterator into this list, not inside [first, last); end() appends
+     * @param first The first element to move
+     * @param last One past the last element to move
+     *
+     * Relinks the nodes without copying them. Works with every allocator,
+     * since the nodes stay in this list.
+     */
+    void splice(const_iterator pos, const_iterator first, const_iterator last)
+    {
+        if (first == last || pos == first || pos == last)
+        {
+            return;
+        }
+        Node *firstNode = first.node;
+        Node *lastNode = last.node == nullptr ? tail : last.node->prev;
+        unlinkChain(firstNode, lastNode);
+        linkChain(pos.node, firstNode, lastNode);
+    }
+
+    /**
+     * @brief Moves the elements [first, last) of other before pos
+     * @param pos An iterator into this list, not inside [first, last); end() appends
+     * @param other The list holding the elements; may be this list
+     * @param first The first element to move
+     * @param last One past the last element to move
+     *
+     * Relinks the nodes without copying them, in time proportional to the
+     * elements moved, to keep both lengths. Only compiles for an allocator
+     * that frees each node on its own, such as HeapNodeAllocator: a list in
+     * a NodePool can only hand over all its nodes, with splice(pos, other),
+     * and moves a range within itself with splice(pos, first, last).
+     */
+    void splice(const_iterator pos, DoublyList &other, const_iterator first, const_iterator last)
+    {
+        static_assert(!Alloc<Node>::RELEASES_ALL,
+                      "a NodePool cannot give up some of its nodes; use splice(pos, other) to move the whole "
+                      "list, or splice(pos, first, last) to move a range within one list");
+        if (this == &other)
+        {
+            splice(pos, first, last);
+            return;
+        }
+        if (first == last)
+        {
+            return;
+        }
+        Node *firstNode = first.node;
+        Node *lastNode = last.node == nullptr ? other.tail : last.node->prev;
+        std::size_t moved = 1;
+        for (Node *node = firstNode; node != lastNode; node = node->next)
+        {
+            moved++;
+        }
+        other.size -= moved;
+        size += moved;
+        other.unlinkChain(firstNode, lastNode);
+        linkChain(pos.node, firstNode, lastNode);
+    }
+
+    /**
+     * @brief Returns the number of elements in the list, in O(1)
+     */
+    std::size_t countNodes() const
+    {
+        return size;
+    }
+
+    /**
+     * @brief Returns true if the list has no elements
+     */
+    bool empty() const
+    {
+        return size == 0;
+    }
+
+    T &front() { return head->data; }
+    const T &front() const { return head->data; }
+    T &back() { return tail->data; }
+    const T &back() const { return tail->data; }
+
+    iterator begin() { return iterator(head, this); }
+    iterator end() { return iterator(nullptr, this); }
+    const_iterator begin() const { return const_iterator(head, this); }
+    const_iterator end() const { return const_iterator(nullptr, this); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+};
+
+#endif // LINKED_LIST_H
@@ -0,0 +1,308 @@
+/**
+ * @file linked_list_demo.cpp
+ * @brief Demonstration of the generic lists in linked_list.h
+ *
+ * This program stores records in a SinglyList and a DoublyList, constructs
+ * them in place without copies, walks them with iterators in both
+ * directions, splices lists together, and checks both lists with both node
+ * allocators against std::list on random operations.
+ */
+
+#include "linked_list.h"
+
+#include <algorithm>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @struct Employee
+ * @brief A sample record stored in the lists
+ */
+struct Employee
+{
+    string name;   ///< The employee's name
+    int age;       ///< The employee's age in years
+    double salary; ///< The employee's yearly salary
+
+    bool operator==(const Employee &other) const
+    {
+        return name == other.name && age == other.age && salary == other.salary;
+    }
+};
+
+/**
+ * @struct Tracked
+ * @brief A value that counts how often it is copied
+ */
+struct Tracked
+{
+    static int copies; ///< Copies made of any Tracked so far
+    int id;            ///< The value compared by operator==
+
+    explicit Tracked(int value) : id(value) {}
+    Tracked(const Tracked &other) : id(other.id) { copies++; }
+    Tracked(Tracked &&other) noexcept : id(other.id) {}
+
+    bool operator==(const Tracked &other) const
+    {
+        return id == other.id;
+    }
+};
+
+int Tracked::copies = 0;
+
+/**
+ * @brief Prints the names of a range of employees
+ */
+template <typename Iterator>
+void printNames(Iterator first, Iterator last)
+{
+    for (; first != last; ++first)
+    {
+        cout << " " << first->name;
+    }
+    cout << endl;
+}
+
+/**
+ * @brief Returns true if the list holds the same values as the expected std::list
+ */
+template <typename List>
+bool sameValues(const List &list, const std::list<int> &expected)
+{
+    return list.countNodes() == expected.size() && vector<int>(list.begin(), list.end()) ==
+                                                       vector<int>(expected.begin(), expected.end());
+}
+
+/**
+ * @brief Applies random operations to a list and to a std::list
+ * @tparam List A SinglyList<int, ...> or DoublyList<int, ...>
+ * @param operations The number of random operations
+ * @return true if the list always matched the std::list
+ */
+template <typename List>
+bool checkAgainstStdList(int operations)
+{
+    mt19937 generator(25);
+    List list;
+    std::list<int> expected;
+    for (int i = 0; i < operations; i++)
+    {
+        int value = (int)(generator() % 100);
+        int other = (int)(generator() % 100);
+        auto found = find(expected.begin(), expected.end(), other);
+        bool present = found != expected.end();
+        bool ok = true;
+        switch (generator() % 8)
+        {
+        case 0:
+            list.insertFirst(value);
+            expected.push_front(value);
+            break;
+        case 1:
+            list.insertLast(value);
+            expected.push_back(value);
+            break;
+        case 2:
+            ok = list.insertAfter(other, value) == present;
+            if (present)
+            {
+                expected.insert(next(found), value);
+            }
+            break;
+        case 3:
+            ok = list.insertBefore(other, value) == present;
+            if (present)
+            {
+                expected.insert(found, value);
+            }
+            break;
+        case 4:
+            ok = list.deleteFirst() == !expected.empty();
+            if (!expected.empty())
+            {
+                expected.pop_front();
+            }
+            break;
+        case 5:
+            ok = list.deleteLast() == !expected.empty();
+            if (!expected.empty())
+            {
+                expected.pop_back();
+            }
+            break;
+        case 6:
+            ok = list.deleteSpecific(other) == present;
+            if (present)
+            {
+                expected.erase(found);
+            }
+            break;
+        default:
+            ok = list.search(other) == present;
+        }
+        if (!ok || !sameValues(list, expected))
+        {
+            return false;
+        }
+    }
+
+    // Moving leaves the source empty and the destination with every value
+    List moved = std::move(list);
+    return list.empty() && sameValues(moved, expected);
+}
+
+/**
+ * @brief Checks splicing DoublyLists against std::list::splice
+ * @tparam Alloc The node allocator template
+ * @return true if every splice matched
+ */
+template <template <typename> class Alloc>
+bool checkSplice()
+{
+    mt19937 generator(26);
+    for (int round = 0; round < 200; round++)
+    {
+        DoublyList<int, Alloc> a, b;
+        std::list<int> expectedA, expectedB;
+        int countA = (int)(generator() % 10), countB = (int)(generator() % 10);
+        for (int i = 0; i < countA; i++)
+        {
+            a.insertLast(i);
+            expectedA.push_back(i);
+        }
+        for (int i = 0; i < countB; i++)
+        {
+            b.insertLast(100 + i);
+            expectedB.push_back(100 + i);
+        }
+
+        // Move a range within a, keeping the position outside it
+        int from = (int)(generator() % (countA + 1)), to = from + (int)(generator() % (countA - from + 1));
+        int at = (int)(generator() % (countA + 1 - (to - from)));
+        at = at >= from ? at + (to - from) : at;
+        auto first = next(a.begin(), from), last = next(a.begin(), to);
+        a.splice(next(a.begin(), at), first, last);
+        expectedA.splice(next(expectedA.begin(), at), expectedA, next(expectedA.begin(), from),
+                         next(expectedA.begin(), to));
+        if (!sameValues(a, expectedA))
+        {
+            return false;
+        }
+
+        // Move part of b into a: only lists whose nodes are freed one by one compile it
+        if constexpr (!Alloc<int>::RELEASES_ALL)
+        {
+            from = (int)(generator() % (countB + 1));
+            to = from + (int)(generator() % (countB - from + 1));
+            at = (int)(generator() % (countA + 1));
+            a.splice(next(a.begin(), at), b, next(b.begin(), from), next(b.begin(), to));
+            expectedA.splice(next(expectedA.begin(), at), expectedB, next(expectedB.begin(), from),
+                             next(expectedB.begin(), to));
+            if (!sameValues(a, expectedA) || !sameValues(b, expectedB))
+            {
+                return false;
+            }
+
+            // Within one list through the same overload
+            int size = (int)a.countNodes();
+            from = (int)(generator() % (size + 1));
+            to = from + (int)(generator() % (size - from + 1));
+            at = (int)(generator() % (size + 1 - (to - from)));
+            at = at >= from ? at + (to - from) : at;
+            a.splice(next(a.begin(), at), a, next(a.begin(), from), next(a.begin(), to));
+            expectedA.splice(next(expectedA.begin(), at), expectedA, next(expectedA.begin(), from),
+                             next(expectedA.begin(), to));
+            if (!sameValues(a, expectedA))
+            {
+                return false;
+            }
+        }
+
+        // Move all of b into a
+        at = (int)(generator() % (a.countNodes() + 1));
+        a.splice(next(a.begin(), at), b);
+        expectedA.splice(next(expectedA.begin(), at), expectedB);
+        if (!sameValues(a, expectedA) || !b.empty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Main function to demonstrate the generic lists
+ * @return 0 if every check passed, 1 otherwise
+ */
+int main()
+{
+    // Construct records in place: the list builds each Employee in its node
+    DoublyList<Employee> staff;
+    staff.emplaceLast("Chen", 45, 91000.0);
+    staff.emplaceLast("Dana", 28, 61000.0);
+    staff.emplaceFirst("Asha", 34, 72000.0);
+    staff.emplace(staff.find(Employee{"Dana", 28, 61000.0}), "Bilal", 28, 58000.0);
+    cout << "Staff:";
+    printNames(staff.begin(), staff.end());
+    cout << "Staff in reverse:";
+    printNames(staff.rbegin(), staff.rend());
+
+    // Splice another list in without copying its records
+    DoublyList<Employee> newHires;
+    newHires.emplaceLast("Eitan", 39, 58000.0);
+    newHires.emplaceLast("Farah", 31, 67000.0);
+    staff.splice(staff.end(), newHires);
+    cout << "After splicing in the new hires (" << newHires.countNodes() << " left there):";
+    printNames(staff.begin(), staff.end());
+
+    staff.deleteSpecific(Employee{"Chen", 45, 91000.0});
+    staff.deleteLast();
+    cout << "After deleting Chen and the last employee:";
+    printNames(staff.begin(), staff.end());
+
+    // Emplacing and splicing copy nothing
+    SinglyList<Tracked> tracked;
+    for (int i = 0; i < 1000; i++)
+    {
+        tracked.emplaceLast(i);
+    }
+    SinglyList<Tracked> more;
+    more.emplaceFirst(-1);
+    tracked.spliceFirst(more);
+    SinglyList<Tracked> movedList = std::move(tracked);
+    cout << "Copies made building, splicing and moving " << movedList.countNodes()
+         << " Tracked values: " << Tracked::copies << endl;
+
+    cout << endl << "Checking against std::list on random operations" << endl;
+    bool allCorrect = Tracked::copies == 0;
+    auto report = [&allCorrect](const char *name, bool correct)
+    {
+        allCorrect = allCorrect && correct;
+        cout << name << ": " << (correct ? "correct" : "WRONG") << endl;
+    };
+    report("SinglyList<int, NodePool>", checkAgainstStdList<SinglyList<int, NodePool>>(100000));
+    report("SinglyList<int, HeapNodeAllocator>", checkAgainstStdList<SinglyList<int, HeapNodeAllocator>>(100000));
+    report("DoublyList<int, NodePool>", checkAgainstStdList<DoublyList<int, NodePool>>(100000));
+    report("DoublyList<int, HeapNodeAllocator>", checkAgainstStdList<DoublyList<int, HeapNodeAllocator>>(100000));
+    report("DoublyList<int, NodePool> splice", checkSplice<NodePool>());
+    report("DoublyList<int, HeapNodeAllocator> splice", checkSplice<HeapNodeAllocator>());
+
+    return allCorrect ? 0 : 1;
+}
+
+/**
+ * Usage Instructions:
+ * 1. Compile the program with C++17 (e.g., g++ -std=c++17 -O2 linked_list_demo.cpp -o linked_list_demo),
+ *    with linked_list.h and node_pool.h in the same directory
+ * 2. Run the compiled executable (e.g., ./linked_list_demo)
+ *
+ * To use the lists in your own code:
+ * 1. #include "linked_list.h"
+ * 2. Declare SinglyList<Record> or DoublyList<Record>, optionally with HeapNodeAllocator as the second argument
+ *    Example: DoublyList<Record> records; records.emplaceLast(id, name);
+ */
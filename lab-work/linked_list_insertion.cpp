@@ -5,9 +5,22 @@
  * This program demonstrates the implementation of a singly linked list in C++.
  * It includes functions for inserting nodes at the beginning and end of the list,
  * as well as displaying the contents of the list.
+ *
+ * Nodes come from a NodePool (node_pool.h) rather than one new per node, and
+ * destroying the list releases the pool's slabs without walking the nodes.
+ *
+ * The list keeps a pointer to its last node and its length, so appending
+ * and counting take O(1) and building a list of n values takes O(n).
+ * Running the program with --benchmark shows the build time growing
+ * linearly, next to the quadratic walk-to-the-end append.
  */
 
+#include "node_pool.h"
+
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <string>
 using namespace std;
 
 /**
@@ -23,27 +36,61 @@ struct Node
 };
 
 /**
- * @class LinkedList
+ * @class BasicLinkedList
  * @brief Implements a singly linked list
  *
  * This class provides methods for creating and manipulating a singly linked list.
+ *
+ * @tparam NodeAllocator Where the nodes come from: NodePool<Node> or
+ *         HeapNodeAllocator<Node> from node_pool.h. Use LinkedList for the pooled list.
  */
-class LinkedList
+template <typename NodeAllocator>
+class BasicLinkedList
 {
 private:
-    Node *head; ///< Pointer to the first node in the list
+    Node *head;          ///< Pointer to the first node in the list
+    Node *tail;          ///< Pointer to the last node in the list
+    int size;            ///< Number of nodes in the list
+    NodeAllocator nodes; ///< Allocates and frees the nodes of this list
 
 public:
     /**
      * @brief Constructor for the LinkedList class
      *
-     * Initializes an empty list with a null head pointer.
+     * Initializes an empty list with null head and tail pointers.
      */
-    LinkedList()
+    BasicLinkedList()
     {
         head = nullptr;
+        tail = nullptr;
+        size = 0;
+    }
+
+    /**
+     * @brief Destructor for the LinkedList class
+     *
+     * A NodePool frees every node at once; otherwise the nodes are deleted one by one.
+     */
+    ~BasicLinkedList()
+    {
+        if constexpr (NodeAllocator::RELEASES_ALL)
+        {
+            nodes.releaseAll();
+        }
+        else
+        {
+            while (head != nullptr)
+            {
+                Node *next = head->next;
+                nodes.destroy(head);
+                head = next;
+            }
+        }
     }
 
+    BasicLinkedList(const BasicLinkedList &) = delete;
+    BasicLinkedList &operator=(const BasicLinkedList &) = delete;
+
     /**
      * @brief Creates a new node with the given value
      * @param value The integer value to be stored in the new node
@@ -51,10 +98,7 @@ public:
      */
     Node *createNode(int value)
     {
-        Node *newNode = new Node();
-        newNode->data = value;
-        newNode->next = nullptr;
-        return newNode;
+        return nodes.create(value, nullptr);
     }
 
     /**
@@ -66,16 +110,7 @@ public:
      */
     void insertFirst(int value)
     {
-        Node *newNode = createNode(value);
-        if (head == nullptr)
-        {
-            head = newNode;
-        }
-        else
-        {
-            newNode->next = head;
-            head = newNode;
-        }
+        prepend(value);
         cout << "Inserted " << value << " at the beginning." << endl;
     }
 
@@ -87,22 +122,54 @@ public:
      * at the end of the list. If the list is empty, the new node becomes the head.
      */
     void insertLast(int value)
+    {
+        append(value);
+        cout << "Inserted " << value << " at the end." << endl;
+    }
+
+    /**
+     * @brief Inserts a new node at the beginning of the list without printing
+     * @param value The integer value to be inserted
+     */
+    void prepend(int value)
     {
         Node *newNode = createNode(value);
-        if (head == nullptr)
+        newNode->next = head;
+        head = newNode;
+        if (tail == nullptr)
+        {
+            tail = newNode;
+        }
+        size++;
+    }
+
+    /**
+     * @brief Inserts a new node at the end of the list without printing
+     * @param value The integer value to be inserted
+     *
+     * Links the node after the tail instead of walking from the head: O(1).
+     */
+    void append(int value)
+    {
+        Node *newNode = createNode(value);
+        if (tail == nullptr)
         {
             head = newNode;
         }
         else
         {
-            Node *temp = head;
-            while (temp->next != nullptr)
-            {
-                temp = temp->next;
-            }
-            temp->next = newNode;
+            tail->next = newNode;
         }
-        cout << "Inserted " << value << " at the end." << endl;
+        tail = newNode;
+        size++;
+    }
+
+    /**
+     * @brief Returns the number of nodes in the list, in O(1)
+     */
+    int countNodes() const
+    {
+        return size;
     }
 
     /**
@@ -130,16 +197,92 @@ public:
     }
 };
 
+/**
+ * @brief The singly linked list, with its nodes in a NodePool
+ */
+using LinkedList = BasicLinkedList<NodePool<Node>>;
+
+/**
+ * @brief Appends to a bare list by walking to its end, as insertLast did before the tail pointer
+ * @param head Reference to the pointer to the head of the list
+ * @param nodes The allocator of the nodes
+ * @param value The value to be appended
+ */
+void appendByWalking(Node *&head, NodePool<Node> &nodes, int value)
+{
+    Node *newNode = nodes.create(value, nullptr);
+    if (head == nullptr)
+    {
+        head = newNode;
+        return;
+    }
+    Node *temp = head;
+    while (temp->next != nullptr)
+    {
+        temp = temp->next;
+    }
+    temp->next = newNode;
+}
+
+/**
+ * @brief Times building lists of growing length with the tail pointer and by walking
+ * @param maxWalk The longest list built by walking, whose time grows quadratically
+ * @return 0 if every list has the expected length, 1 otherwise
+ */
+int runBenchmark(int maxWalk)
+{
+    bool lengthsOk = true;
+    cout << "nodes\ttail ms\tns/append\twalk ms" << endl;
+    for (int n = 1000; n <= 1000000; n *= 10)
+    {
+        LinkedList list;
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < n; i++)
+        {
+            list.append(i);
+        }
+        auto end = chrono::steady_clock::now();
+        double tailMs = chrono::duration<double, milli>(end - start).count();
+        lengthsOk = lengthsOk && list.countNodes() == n;
+        cout << n << "\t" << tailMs << "\t" << tailMs * 1e6 / n << "\t\t";
+
+        if (n <= maxWalk)
+        {
+            NodePool<Node> nodes;
+            Node *head = nullptr;
+            start = chrono::steady_clock::now();
+            for (int i = 0; i < n; i++)
+            {
+                appendByWalking(head, nodes, i);
+            }
+            end = chrono::steady_clock::now();
+            cout << chrono::duration<double, milli>(end - start).count() << endl;
+        }
+        else
+        {
+            cout << "skipped (O(n^2))" << endl;
+        }
+    }
+    return lengthsOk ? 0 : 1;
+}
+
 /**
  * @brief Main function implementing a menu-driven interface for the LinkedList
+ * @param argc Number of command-line arguments
+ * @param argv Pass --benchmark [maxWalk] to time list building instead
  * @return 0 on successful execution
  *
  * This function creates a LinkedList object and provides a menu-driven interface
  * for the user to perform operations on the list, such as inserting nodes at the
  * beginning or end, displaying the list, and exiting the program.
  */
-int main()
+int main(int argc, char *argv[])
 {
+    if (argc > 1 && string(argv[1]) == "--benchmark")
+    {
+        return runBenchmark(argc > 2 ? atoi(argv[2]) : 10000);
+    }
+
     LinkedList list;
     int choice, value;
 
@@ -172,4 +315,14 @@ int main()
     } while (choice != 4);
 
     return 0;
-}
\ No newline at end of file
+}
+
+/**
+ * Usage Instructions:
+ * 1. Compile the program with C++17 (e.g., g++ -std=c++17 -O2 linked_list_insertion.cpp -o linked_list_insertion),
+ *    with node_pool.h in the same directory
+ * 2. Run the compiled executable (e.g., ./linked_list_insertion)
+ * 3. Choose menu options to insert values and display the list
+ *
+ * To time building long lists, run ./linked_list_insertion --benchmark [maxWalk]
+ */
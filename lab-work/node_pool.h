@@ -0,0 +1,309 @@
+/**
+ * @file node_pool.h
+ * @brief Header-only node allocators for the linked structures in lab-work
+ *
+ * The trees and lists in lab-work allocate every node with its own call to
+ * new. NodePool instead carves nodes out of large slabs: allocation is a
+ * pointer bump or a pop from a free list of destroyed nodes, nodes allocated
+ * together sit next to each other in memory, and the per-allocation header
+ * of malloc is gone. Destroying a whole container releases the slabs without
+ * visiting its nodes.
+ *
+ * HeapNodeAllocator has the same interface and calls new and delete for
+ * every node, so a container written against the interface can be built
+ * with either and compared. The interface is:
+ *     T *create(args...)   constructs a node as T{args...}
+ *     void destroy(T *)    destroys one node and makes its memory reusable
+ *     void reserve(n)      makes the next n creates contiguous, if supported
+ *     void adopt(other)    takes over the nodes of another allocator, so they
+ *                          can be linked into this allocator's container
+ *     RELEASES_ALL         true if releaseAll() frees every node at once
+ *
+ * Requires C++17.
+ */
+
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @class NodePool
+ * @brief A slab allocator with a free list for nodes of one type
+ *
+ * Slabs double in size, up to MAX_SLAB_NODES nodes, so building n nodes
+ * takes O(log n) slab allocations at first and then one per MAX_SLAB_NODES.
+ * Pages of a slab that are never used are never touched, so they do not
+ * count towards the resident set size.
+ */
+template <typename T>
+class NodePool
+{
+public:
+    static constexpr bool RELEASES_ALL = true; ///< releaseAll frees every node without visiting it
+
+private:
+    static constexpr std::size_t FIRST_SLAB_NODES = 64;      ///< Nodes in the first slab
+    static constexpr std::size_t MAX_SLAB_NODES = 1u << 20;  ///< Slabs stop doubling at this many nodes
+
+    /**
+     * @union Slot
+     * @brief Storage for one node, or the free-list link once it is destroyed
+     */
+    union Slot
+    {
+        Slot *nextFree;                                  ///< The next destroyed slot
+        alignas(T) unsigned char storage[sizeof(T)];     ///< The node itself
+    };
+
+    std::vector<Slot *> slabs;  ///< Every slab, so releaseAll can free them
+    Slot *cursor;               ///< The next never-used slot of the current slab
+    Slot *slabEnd;              ///< One past the last slot of the current slab
+    Slot *freeList;             ///< Destroyed slots, reused before the cursor advances
+    std::size_t nextSlabNodes;  ///< Size of the next slab to allocate
+    std::size_t liveNodes;      ///< Nodes created and not yet destroyed
+
+    /**
+     * @brief Allocates a slab of at least count slots and makes it current
+     */
+    void addSlab(std::size_t count)
+    {
+        Slot *slab = static_cast<Slot *>(::operator new(count * sizeof(Slot), std::align_val_t(alignof(Slot))));
+        slabs.push_back(slab);
+        cursor = slab;
+        slabEnd = slab + count;
+        if (nextSlabNodes < MAX_SLAB_NODES)
+        {
+            nextSlabNodes *= 2;
+        }
+    }
+
+    /**
+     * @brief Returns every slab to the heap and resets the pool to empty
+     */
+    void freeSlabs()
+    {
+        for (Slot *slab : slabs)
+        {
+            ::operator delete(slab, std::align_val_t(alignof(Slot)));
+        }
+        slabs.clear();
+        cursor = slabEnd = nullptr;
+        freeList = nullptr;
+        nextSlabNodes = FIRST_SLAB_NODES;
+        liveNodes = 0;
+    }
+
+public:
+    /**
+     * @brief Construct an empty pool; no memory is allocated until the first create
+     */
+    NodePool() : cursor(nullptr), slabEnd(nullptr), freeList(nullptr), nextSlabNodes(FIRST_SLAB_NODES), liveNodes(0)
+    {
+    }
+
+    /**
+     * @brief Destroy the pool, freeing every slab
+     *
+     * Node destructors are not run, so the pool must be empty or T must be
+     * trivially destructible.
+     */
+    ~NodePool()
+    {
+        freeSlabs();
+    }
+
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    /**
+     * @brief Take over the slabs of another pool, leaving it empty
+     */
+    NodePool(NodePool &&other) noexcept : NodePool()
+    {
+        swap(other);
+    }
+
+    /**
+     * @brief Free this pool's slabs and take over those of another pool
+     */
+    NodePool &operator=(NodePool &&other) noexcept
+    {
+        if (this != &other)
+        {
+            freeSlabs();
+            swap(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Exchange the contents of two pools
+     */
+    void swap(NodePool &other) noexcept
+    {
+        std::swap(slabs, other.slabs);
+        std::swap(cursor, other.cursor);
+        std::swap(slabEnd, other.slabEnd);
+        std::swap(freeList, other.freeList);
+        std::swap(nextSlabNodes, other.nextSlabNodes);
+        std::swap(liveNodes, other.liveNodes);
+    }
+
+    /**
+     * @brief Construct a node as T{args...} in a free slot
+     * @param args The initializers of the node
+     * @return Pointer to the new node
+     */
+    template <typename... Args>
+    T *create(Args &&...args)
+    {
+        Slot *slot;
+        if (freeList != nullptr)
+        {
+            slot = freeList;
+            freeList = freeList->nextFree;
+        }
+        else
+        {
+            if (cursor == slabEnd)
+            {
+                addSlab(nextSlabNodes);
+            }
+            slot = cursor++;
+        }
+        liveNodes++;
+        return new (slot->storage) T{std::forward<Args>(args)...};
+    }
+
+    /**
+     * @brief Destroy a node created by this pool and put its slot on the free list
+     * @param node The node
+     */
+    void destroy(T *node)
+    {
+        node->~T();
+        Slot *slot = reinterpret_cast<Slot *>(node);
+        slot->nextFree = freeList;
+        freeList = slot;
+        liveNodes--;
+    }
+
+    /**
+     * @brief Make the next count creates, if the free list is empty, take consecutive slots
+     * @param count The number of nodes about to be created
+     */
+    void reserve(std::size_t count)
+    {
+        if ((std::size_t)(slabEnd - cursor) < count)
+        {
+            addSlab(count > nextSlabNodes ? count : nextSlabNodes);
+        }
+    }
+
+    /**
+     * @brief Take over the slabs and nodes of another pool, leaving it empty
+     * @param other The pool whose nodes now belong to this one
+     *
+     * Lets a container link in the nodes of another container without
+     * copying them. Slots other had freed join this free list; if this
+     * pool's current slab is used up, creation continues in other's.
+     */
+    void adopt(NodePool &other)
+    {
+        if (this == &other)
+        {
+            return;
+        }
+        slabs.insert(slabs.end(), other.slabs.begin(), other.slabs.end());
+        while (other.freeList != nullptr)
+        {
+            Slot *slot = other.freeList;
+            other.freeList = slot->nextFree;
+            slot->nextFree = freeList;
+            freeList = slot;
+        }
+        if (cursor == slabEnd)
+        {
+            cursor = other.cursor;
+            slabEnd = other.slabEnd;
+        }
+        liveNodes += other.liveNodes;
+
+        other.slabs.clear();
+        other.cursor = other.slabEnd = nullptr;
+        other.nextSlabNodes = FIRST_SLAB_NODES;
+        other.liveNodes = 0;
+    }
+
+    /**
+     * @brief Free every node at once, without visiting them
+     *
+     * Takes time proportional to the number of slabs, not nodes.
+     */
+    void releaseAll()
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "releaseAll skips destructors; destroy each node of this type instead");
+        freeSlabs();
+    }
+
+    /**
+     * @brief Returns the number of nodes created and not yet destroyed
+     */
+    std::size_t size() const
+    {
+        return liveNodes;
+    }
+};
+
+/**
+ * @class HeapNodeAllocator
+ * @brief Allocates every node with new and frees it with delete
+ *
+ * The behaviour of the containers before NodePool, behind the same
+ * interface. It keeps no state, so a container must destroy each node.
+ */
+template <typename T>
+class HeapNodeAllocator
+{
+public:
+    static constexpr bool RELEASES_ALL = false; ///< Nodes must be destroyed one by one
+
+    /**
+     * @brief Construct a node as T{args...} with new
+     */
+    template <typename... Args>
+    T *create(Args &&...args)
+    {
+        return new T{std::forward<Args>(args)...};
+    }
+
+    /**
+     * @brief Delete a node created by create
+     */
+    void destroy(T *node)
+    {
+        delete node;
+    }
+
+    /**
+     * @brief Does nothing: separately allocated nodes cannot be made contiguous
+     */
+    void reserve(std::size_t)
+    {
+    }
+
+    /**
+     * @brief Does nothing: every node is freed on its own, whichever container holds it
+     */
+    void adopt(HeapNodeAllocator &)
+    {
+    }
+};
+
+#endif // NODE_POOL_H
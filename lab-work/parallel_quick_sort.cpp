@@ -0,0 +1,116 @@
+/**
+ * @file parallel_quick_sort.cpp
+ * @brief Parallel quicksort on a work-stealing thread pool
+ *
+ * This file contains a multi-threaded variant of quickSort. Large subarrays
+ * are partitioned and the resulting subranges are pushed onto per-thread
+ * deques; idle threads steal work from the tail of other threads' deques.
+ * Subarrays below a size threshold are finished by the sequential introsort
+ * kernel from quick_sort.h. The sort itself lives in parallel_quick_sort.h,
+ * namespace parallel_quick_sort, which sort_benchmark.cpp includes too; the
+ * main function here benchmarks scaling from one thread up to the number of
+ * hardware threads.
+ */
+
+#include "parallel_quick_sort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+using namespace parallel_quick_sort;
+
+/**
+ * @brief Checks whether an array is sorted in ascending order
+ * @param arr The array to be checked
+ * @param n The number of elements in the array
+ * @return true if the array is sorted, false otherwise
+ */
+bool isSorted(int arr[], int n)
+{
+    for (int i = 1; i < n; i++)
+    {
+        if (arr[i] < arr[i - 1])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Benchmarks parallelQuickSort from one thread up to the hardware thread count
+ * @param argc The number of command-line arguments
+ * @param argv argv[1] is the array size, argv[2] the maximum thread count (both optional)
+ * @return 0 on success, 1 if any run produced an unsorted array
+ */
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 20000000;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : (int)thread::hardware_concurrency();
+    if (maxThreads < 1)
+    {
+        maxThreads = 1;
+    }
+
+    // Generate the input once so every run sorts identical data
+    vector<int> input(n);
+    mt19937 generator(12345);
+    for (int i = 0; i < n; i++)
+    {
+        input[i] = (int)generator();
+    }
+
+    // Thread counts 1, 2, 4, ... plus maxThreads itself
+    vector<int> threadCounts;
+    for (int t = 1; t < maxThreads; t *= 2)
+    {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(maxThreads);
+
+    cout << "Sorting " << n << " random ints" << endl;
+    cout << "threads\ttime_ms\tspeedup" << endl;
+
+    double baseMs = 0;
+    bool allSorted = true;
+    vector<int> arr(n);
+    for (int threads : threadCounts)
+    {
+        copy(input.begin(), input.end(), arr.begin());
+
+        auto start = chrono::steady_clock::now();
+        parallelQuickSort(arr.data(), n, threads);
+        auto end = chrono::steady_clock::now();
+
+        double ms = chrono::duration<double, milli>(end - start).count();
+        if (threads == 1)
+        {
+            baseMs = ms;
+        }
+        bool sorted = isSorted(arr.data(), n);
+        allSorted = allSorted && sorted;
+
+        cout << threads << "\t" << ms << "\t" << baseMs / ms << (sorted ? "" : "\tNOT SORTED") << endl;
+    }
+
+    return allSorted ? 0 : 1;
+}
+
+/**
+ * Usage Instructions:
+ * 1. Compile with optimizations and thread support
+ *    (e.g., g++ -O2 -pthread parallel_quick_sort.cpp -o parallel_quick_sort)
+ * 2. Run the benchmark (e.g., ./parallel_quick_sort 500000000 32 to sort
+ *    500M ints with 1, 2, 4, 8, 16 and 32 threads)
+ * 3. The program prints the time and speedup over one thread for each thread count
+ *
+ * To use the parallel sort in your own code:
+ * 1. #include "parallel_quick_sort.h" (it includes quick_sort.h) and link with -pthread
+ * 2. Call parallel_quick_sort::parallelQuickSort(your_array, array_size, thread_count)
+ *    Raise the optional cutoff argument if tasks are too fine-grained for your machine.
+ */
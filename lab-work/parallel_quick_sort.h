@@ -0,0 +1,309 @@
+/**
+ * @file parallel_quick_sort.h
+ * @brief Header-only parallel quicksort of int arrays on a work-stealing thread pool
+ *
+ * The kernel of parallel_quick_sort.cpp, kept in a header so that
+ * sort_benchmark.cpp runs the same code as the scaling benchmark. Large
+ * subarrays are partitioned three ways and one side is pushed onto the
+ * worker's deque, where idle threads steal it; subarrays below the cutoff
+ * run the sequential introSortLoop of quick_sort.h. Everything is in
+ * namespace parallel_quick_sort.
+ *
+ * Requires C++17 and thread support (e.g., -pthread).
+ */
+
+#ifndef PARALLEL_QUICK_SORT_H
+#define PARALLEL_QUICK_SORT_H
+
+#include "quick_sort.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallel_quick_sort
+{
+
+const int PARALLEL_CUTOFF = 1 << 15; ///< Default size below which subarrays are sorted sequentially
+
+/**
+ * @struct SortTask
+ * @brief A subarray arr[low..high] waiting to be sorted
+ */
+struct SortTask
+{
+    int low;        ///< The starting index of the subarray
+    int high;       ///< The ending index of the subarray
+    int depthLimit; ///< Partitioning levels left before falling back to heap sort
+};
+
+/**
+ * @struct WorkerQueue
+ * @brief The deque of pending tasks owned by one worker thread
+ *
+ * The owner pushes and pops at the front; other workers steal from the back,
+ * where the oldest (and therefore largest) subarrays sit.
+ */
+struct WorkerQueue
+{
+    std::mutex lock;            ///< Guards the task deque
+    std::deque<SortTask> tasks; ///< Pending subarrays
+};
+
+/**
+ * @class WorkStealingPool
+ * @brief Runs a parallel quicksort of one array on a fixed set of threads
+ */
+class WorkStealingPool
+{
+private:
+    int *arr;                         ///< The array being sorted
+    int cutoff;                       ///< Subarrays this small are sorted sequentially
+    std::vector<WorkerQueue> queues;       ///< One deque per worker thread
+    std::atomic<long long> remaining;      ///< Elements not yet in their final position
+    std::atomic<int> queuedTasks;          ///< Tasks pushed and not yet popped or stolen
+    std::mutex idleLock;                   ///< Guards the sleep of idle workers on workAvailable
+    std::condition_variable workAvailable; ///< Signalled when a task is pushed or the sort is done
+
+    /**
+     * @brief Wakes idle workers, taking idleLock so a worker about to sleep cannot miss it
+     * @param all true to wake every worker, false to wake one
+     */
+    void wakeIdle(bool all)
+    {
+        {
+            std::lock_guard<std::mutex> guard(idleLock);
+        }
+        if (all)
+        {
+            workAvailable.notify_all();
+        }
+        else
+        {
+            workAvailable.notify_one();
+        }
+    }
+
+    /**
+     * @brief Records that count elements reached their final position
+     *
+     * The worker that places the last element wakes every idle worker so they can exit.
+     */
+    void finish(long long count)
+    {
+        if ((remaining -= count) == 0)
+        {
+            wakeIdle(true);
+        }
+    }
+
+    /**
+     * @brief Pushes a task onto the front of a worker's own deque
+     * @param id The index of the owning worker
+     * @param task The task to push
+     */
+    void pushTask(int id, const SortTask &task)
+    {
+        {
+            std::lock_guard<std::mutex> guard(queues[id].lock);
+            queues[id].tasks.push_front(task);
+        }
+        queuedTasks++;
+        wakeIdle(false);
+    }
+
+    /**
+     * @brief Pops the most recently pushed task from a worker's own deque
+     * @param id The index of the owning worker
+     * @param task Set to the popped task
+     * @return true if a task was popped, false if the deque was empty
+     */
+    bool popTask(int id, SortTask &task)
+    {
+        std::lock_guard<std::mutex> guard(queues[id].lock);
+        if (queues[id].tasks.empty())
+        {
+            return false;
+        }
+        task = queues[id].tasks.front();
+        queues[id].tasks.pop_front();
+        queuedTasks--;
+        return true;
+    }
+
+    /**
+     * @brief Steals the oldest task from the tail of another worker's deque
+     * @param id The index of the stealing worker
+     * @param task Set to the stolen task
+     * @return true if a task was stolen, false if every other deque was empty
+     */
+    bool stealTask(int id, SortTask &task)
+    {
+        int numThreads = (int)queues.size();
+        for (int offset = 1; offset < numThreads; offset++)
+        {
+            WorkerQueue &victim = queues[(id + offset) % numThreads];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.tasks.empty())
+            {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                queuedTasks--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Sorts one task, publishing one side of every partition for stealing
+     * @param id The index of the worker running the task
+     * @param task The subarray to sort
+     */
+    void runTask(int id, SortTask task)
+    {
+        int low = task.low;
+        int high = task.high;
+        int depthLimit = task.depthLimit;
+
+        while (high - low + 1 > cutoff)
+        {
+            if (depthLimit == 0)
+            {
+                quick_sort::heapSort(arr + low, high - low + 1);
+                finish(high - low + 1);
+                return;
+            }
+            depthLimit--;
+
+            int lt, gt;
+            quick_sort::partition3Way(arr, low, high, lt, gt);
+            finish(gt - lt + 1); // The pivot band is in its final position
+
+            // Offer the smaller side to other workers, keep partitioning the larger one;
+            // an empty side is not worth a task
+            if (lt - low < high - gt)
+            {
+                if (low < lt)
+                {
+                    pushTask(id, {low, lt - 1, depthLimit});
+                }
+                low = gt + 1;
+            }
+            else
+            {
+                if (gt < high)
+                {
+                    pushTask(id, {gt + 1, high, depthLimit});
+                }
+                high = lt - 1;
+            }
+        }
+
+        if (low <= high)
+        {
+            quick_sort::introSortLoop(arr, low, high, depthLimit);
+            finish(high - low + 1);
+        }
+    }
+
+    /**
+     * @brief Main loop of a worker thread
+     * @param id The index of the worker
+     *
+     * Runs tasks from the worker's own deque, steals when it is empty, and
+     * exits once every element of the array is in its final position. A
+     * worker that finds nothing to steal sleeps until a task is pushed,
+     * rather than spinning on cores the busy workers could use.
+     */
+    void workerLoop(int id)
+    {
+        SortTask task;
+        while (remaining > 0)
+        {
+            if (popTask(id, task) || stealTask(id, task))
+            {
+                runTask(id, task);
+            }
+            else
+            {
+                std::unique_lock<std::mutex> guard(idleLock);
+                workAvailable.wait(guard, [this] { return remaining == 0 || queuedTasks > 0; });
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new WorkStealingPool object
+     * @param numThreads The number of worker threads
+     * @param sequentialCutoff Subarrays this small are sorted sequentially
+     */
+    WorkStealingPool(int numThreads, int sequentialCutoff)
+        : arr(nullptr), cutoff(sequentialCutoff), queues(numThreads), remaining(0), queuedTasks(0)
+    {
+    }
+
+    /**
+     * @brief Sorts an array using every worker thread
+     * @param array The array to be sorted
+     * @param n The number of elements in the array
+     * @param depthLimit Partitioning levels allowed before falling back to heap sort
+     */
+    void sort(int array[], int n, int depthLimit)
+    {
+        arr = array;
+        remaining = n;
+        pushTask(0, {0, n - 1, depthLimit});
+
+        // The calling thread acts as worker 0
+        std::vector<std::thread> workers;
+        for (int id = 1; id < (int)queues.size(); id++)
+        {
+            workers.emplace_back(&WorkStealingPool::workerLoop, this, id);
+        }
+        workerLoop(0);
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+    }
+};
+
+/**
+ * @brief Sorts an array with a parallel work-stealing quicksort
+ *
+ * Subarrays larger than cutoff are partitioned three ways and one side is
+ * pushed onto the worker's deque where idle threads can steal it. Smaller
+ * subarrays run the sequential introsort kernel of quick_sort.h. The heap
+ * sort fallback at depth 2*log2(n) keeps the total work O(n log n).
+ *
+ * @param arr The array to be sorted
+ * @param n The number of elements in the array
+ * @param numThreads The number of threads to use; 1 runs the sequential kernel
+ * @param cutoff Subarrays this small are never split across threads
+ */
+inline void parallelQuickSort(int arr[], int n, int numThreads, int cutoff = PARALLEL_CUTOFF)
+{
+    int log2n = 0;
+    for (int size = n; size > 1; size >>= 1)
+    {
+        log2n++;
+    }
+
+    if (numThreads <= 1 || n <= cutoff)
+    {
+        quick_sort::introSortLoop(arr, 0, n - 1, 2 * log2n);
+        return;
+    }
+
+    WorkStealingPool pool(numThreads, cutoff);
+    pool.sort(arr, n, 2 * log2n);
+}
+
+} // namespace parallel_quick_sort
+
+#endif // PARALLEL_QUICK_SORT_H
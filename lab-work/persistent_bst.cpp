@@ -0,0 +1,538 @@
+/**
+ * @file persistent_bst.cpp
+ * @brief Implementation of a persistent (immutable) Binary Search Tree
+ *
+ * The BST in binary_search_tree.cpp changes in place, so handing a
+ * consistent view of it to a long-running reader means deep-copying every
+ * node. PersistentBST never changes a node once it is built:
+ *
+ * - insert copies only the nodes on the path from the root to the new leaf
+ *   and returns a new tree whose root is the copied root. Every subtree off
+ *   that path is shared with the old tree, which stays valid and unchanged.
+ * - The tree is kept AVL balanced: each node stores its height, and the
+ *   copies on the path are rotated where two sibling heights differ by two.
+ *   The path is therefore O(log n) long whatever order the keys arrive in,
+ *   and a rotation only builds new nodes from shared subtrees.
+ * - Each node counts the references to it, so a node is freed when the
+ *   last version that reaches it is destroyed. The counts are atomic, so
+ *   versions may be read and dropped on different threads.
+ * - A snapshot is a copy of a PersistentBST: one reference-count increment,
+ *   whatever the size of the tree.
+ *
+ * Running the program with --benchmark times building the tree from random
+ * and ascending keys and compares taking a snapshot with deep-copying it.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+struct PersistentNode;
+
+/**
+ * @class NodeRef
+ * @brief An owning pointer to a PersistentNode, counted inside the node
+ *
+ * Works like shared_ptr<const PersistentNode>, but the count lives in the
+ * node, so a node is one allocation, and releasing the last reference frees
+ * the subtree below it with an explicit stack instead of one nested
+ * destructor call per level.
+ */
+class NodeRef
+{
+private:
+    PersistentNode *node; ///< The node owned, or nullptr
+
+    /**
+     * @brief Drops one reference to node, freeing it and every child it held the last reference to
+     */
+    static void release(PersistentNode *node);
+
+public:
+    /**
+     * @brief Construct an empty reference
+     */
+    NodeRef(nullptr_t = nullptr) : node(nullptr) {}
+
+    /**
+     * @brief Take ownership of a node just created with new, whose count starts at 1
+     */
+    explicit NodeRef(PersistentNode *created) : node(created) {}
+
+    NodeRef(const NodeRef &other);
+
+    NodeRef(NodeRef &&other) noexcept : node(other.node)
+    {
+        other.node = nullptr;
+    }
+
+    NodeRef &operator=(NodeRef other) noexcept
+    {
+        swap(node, other.node);
+        return *this;
+    }
+
+    ~NodeRef()
+    {
+        release(node);
+    }
+
+    /**
+     * @brief Returns the node, which may not be modified through any reference
+     */
+    const PersistentNode *get() const
+    {
+        return node;
+    }
+
+    const PersistentNode *operator->() const
+    {
+        return node;
+    }
+
+    explicit operator bool() const
+    {
+        return node != nullptr;
+    }
+
+    bool operator==(const NodeRef &other) const
+    {
+        return node == other.node;
+    }
+};
+
+/**
+ * @struct PersistentNode
+ * @brief Represents a node of the persistent Binary Search Tree
+ *
+ * Nodes are created fully formed and only reached through NodeRef, which
+ * hands out pointers to const, so they are never modified after
+ * construction.
+ */
+struct PersistentNode
+{
+    const int data;      ///< The value stored in the node
+    const int height;    ///< Nodes on the longest path down to a leaf, this one included
+    NodeRef left;        ///< Pointer to the left child node, possibly shared
+    NodeRef right;       ///< Pointer to the right child node, possibly shared
+    atomic<long> owners; ///< Number of NodeRefs pointing at this node
+
+    /**
+     * @brief Construct a new node with one owner
+     * @param value The integer value to be stored in the node
+     * @param leftChild The left subtree
+     * @param rightChild The right subtree
+     */
+    PersistentNode(int value, NodeRef leftChild, NodeRef rightChild)
+        : data(value),
+          height(1 + max(leftChild ? leftChild->height : 0, rightChild ? rightChild->height : 0)),
+          left(move(leftChild)), right(move(rightChild)), owners(1)
+    {
+    }
+};
+
+inline NodeRef::NodeRef(const NodeRef &other) : node(other.node)
+{
+    if (node != nullptr)
+    {
+        // A new owner needs no ordering: it was handed the node by an existing one
+        node->owners.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+inline void NodeRef::release(PersistentNode *node)
+{
+    // acq_rel: each owner's decrement releases its reads of the node, and
+    // the one that drops the count to zero acquires all of them before it
+    // frees the node. No other thread can reach the node after that, so it
+    // may detach the children.
+    vector<PersistentNode *> pending;
+    while (node != nullptr)
+    {
+        if (node->owners.fetch_sub(1, memory_order_acq_rel) == 1)
+        {
+            for (NodeRef *child : {&node->left, &node->right})
+            {
+                if (child->node != nullptr)
+                {
+                    pending.push_back(child->node);
+                    child->node = nullptr;
+                }
+            }
+            delete node;
+        }
+        if (pending.empty())
+        {
+            break;
+        }
+        node = pending.back();
+        pending.pop_back();
+    }
+}
+
+/**
+ * @class PersistentBST
+ * @brief An immutable Binary Search Tree; insert returns a new version
+ *
+ * This class provides methods for inserting values, searching for values,
+ * and performing an in-order traversal of the tree. Copying a
+ * PersistentBST takes an O(1) snapshot. A single PersistentBST object is
+ * not synchronized, but separate copies may be used from separate threads.
+ */
+class PersistentBST
+{
+private:
+    NodeRef root; ///< Pointer to the root node of this version
+    int size;     ///< Number of keys in this version
+
+    /**
+     * @brief Construct a version from a root and key count
+     */
+    PersistentBST(NodeRef newRoot, int keys) : root(move(newRoot)), size(keys) {}
+
+    /**
+     * @brief Allocates a node with one owner, the returned reference
+     */
+    static NodeRef makeNode(int value, NodeRef left, NodeRef right)
+    {
+        return NodeRef(new PersistentNode(value, move(left), move(right)));
+    }
+
+    /**
+     * @brief Returns the height of a subtree; 0 for an empty one
+     */
+    static int heightOf(const NodeRef &node)
+    {
+        return node ? node->height : 0;
+    }
+
+    /**
+     * @brief Builds a node from value and two AVL subtrees whose heights differ by at most two
+     * @return The root of a balanced subtree holding the same keys
+     *
+     * Rotates once or twice when one side is two taller than the other, as
+     * AVL insertion does, creating new nodes for the rotated ones and sharing
+     * every subtree below them.
+     */
+    static NodeRef balance(int value, NodeRef left, NodeRef right)
+    {
+        if (heightOf(left) > heightOf(right) + 1)
+        {
+            const PersistentNode *tall = left.get();
+            if (heightOf(tall->left) >= heightOf(tall->right))
+            {
+                return makeNode(tall->data, tall->left, makeNode(value, tall->right, move(right)));
+            }
+            const PersistentNode *middle = tall->right.get();
+            return makeNode(middle->data, makeNode(tall->data, tall->left, middle->left),
+                            makeNode(value, middle->right, move(right)));
+        }
+        if (heightOf(right) > heightOf(left) + 1)
+        {
+            const PersistentNode *tall = right.get();
+            if (heightOf(tall->right) >= heightOf(tall->left))
+            {
+                return makeNode(tall->data, makeNode(value, move(left), tall->left), tall->right);
+            }
+            const PersistentNode *middle = tall->left.get();
+            return makeNode(middle->data, makeNode(value, move(left), middle->left),
+                            makeNode(tall->data, middle->right, tall->right));
+        }
+        return makeNode(value, move(left), move(right));
+    }
+
+    /**
+     * @brief Helper function to insert a value by copying the search path
+     * @param top The root of the old tree
+     * @param value The value to be inserted
+     * @param inserted Set to false if the value is already present
+     * @return The root of the new tree; top itself if nothing changed
+     *
+     * Walks down iteratively recording the path, then builds the copies from
+     * the new leaf back up, each sharing the child that is off the path and
+     * rebalanced as it is built.
+     */
+    static NodeRef insertCopy(const NodeRef &top, int value, bool &inserted)
+    {
+        // An AVL tree of height 64 would hold more than 2^44 keys
+        const PersistentNode *path[64];
+        int depth = 0;
+        const PersistentNode *node = top.get();
+        while (node != nullptr)
+        {
+            if (value == node->data)
+            {
+                // Already present: the old tree is the new one
+                inserted = false;
+                return top;
+            }
+            path[depth++] = node;
+            node = value < node->data ? node->left.get() : node->right.get();
+        }
+
+        inserted = true;
+        NodeRef child = makeNode(value, nullptr, nullptr);
+        for (int i = depth - 1; i >= 0; i--)
+        {
+            const PersistentNode *parent = path[i];
+            child = value < parent->data ? balance(parent->data, move(child), parent->right)
+                                         : balance(parent->data, parent->left, move(child));
+        }
+        return child;
+    }
+
+    /**
+     * @brief Helper function to copy every node of a subtree
+     * @param top The subtree root
+     * @return The root of the copy, which shares no node with the original
+     *
+     * Visits the nodes in post-order with an explicit stack, so each copy is
+     * built after the copies of its children, which wait on a second stack.
+     */
+    static NodeRef copyNodes(const PersistentNode *top)
+    {
+        vector<pair<const PersistentNode *, bool>> pending{{top, false}};
+        vector<NodeRef> copies;
+        while (!pending.empty())
+        {
+            const PersistentNode *node = pending.back().first;
+            bool childrenCopied = pending.back().second;
+            pending.pop_back();
+            if (node == nullptr)
+            {
+                copies.emplace_back();
+            }
+            else if (!childrenCopied)
+            {
+                pending.push_back({node, true});
+                pending.push_back({node->right.get(), false});
+                pending.push_back({node->left.get(), false});
+            }
+            else
+            {
+                NodeRef right = move(copies.back());
+                copies.pop_back();
+                NodeRef left = move(copies.back());
+                copies.pop_back();
+                copies.push_back(makeNode(node->data, move(left), move(right)));
+            }
+        }
+        return move(copies.back());
+    }
+
+    /**
+     * @brief Helper function for in-order traversal
+     * @param top The root of the subtree to print
+     */
+    static void inOrder(const PersistentNode *top)
+    {
+        vector<const PersistentNode *> stack;
+        const PersistentNode *node = top;
+        while (node != nullptr || !stack.empty())
+        {
+            while (node != nullptr)
+            {
+                stack.push_back(node);
+                node = node->left.get();
+            }
+            node = stack.back();
+            stack.pop_back();
+            cout << node->data << " ";
+            node = node->right.get();
+        }
+    }
+
+public:
+    /**
+     * @brief Construct an empty tree
+     */
+    PersistentBST() : root(nullptr), size(0) {}
+
+    /**
+     * @brief Return a new version with value inserted; this version is unchanged
+     * @param value The value to be inserted
+     * @return The new version, which shares every node off the search path with this one
+     *
+     * @note Copies O(log n) nodes whatever order the keys arrive in.
+     */
+    PersistentBST insert(int value) const
+    {
+        bool inserted;
+        NodeRef newRoot = insertCopy(root, value, inserted);
+        return PersistentBST(move(newRoot), inserted ? size + 1 : size);
+    }
+
+    /**
+     * @brief Search for a value in this version
+     * @param value The value to search for
+     * @return true if the value is found, false otherwise
+     */
+    bool search(int value) const
+    {
+        const PersistentNode *node = root.get();
+        while (node != nullptr && node->data != value)
+        {
+            node = value < node->data ? node->left.get() : node->right.get();
+        }
+        return node != nullptr;
+    }
+
+    /**
+     * @brief Perform an in-order traversal of this version
+     *
+     * Prints the values of the tree in ascending order
+     */
+    void inOrder() const
+    {
+        inOrder(root.get());
+        cout << endl;
+    }
+
+    /**
+     * @brief Returns the height of this version; at most 1.44 log2(n + 2)
+     */
+    int height() const
+    {
+        return heightOf(root);
+    }
+
+    /**
+     * @brief Returns the number of keys in this version
+     */
+    int count() const
+    {
+        return size;
+    }
+
+    /**
+     * @brief Return a copy of this version that shares no node with it
+     *
+     * What a snapshot of a mutable tree costs; copying a PersistentBST is
+     * enough to snapshot it.
+     */
+    PersistentBST deepCopy() const
+    {
+        return PersistentBST(copyNodes(root.get()), size);
+    }
+
+    /**
+     * @brief Returns true if two versions share the same root node
+     */
+    bool sharesRootWith(const PersistentBST &other) const
+    {
+        return root == other.root;
+    }
+};
+
+/**
+ * @brief Compares taking a snapshot with deep-copying the tree
+ * @param n The number of random keys in the tree
+ * @return 0 if the snapshot stayed unchanged while the tree grew, 1 otherwise
+ */
+int runBenchmark(int n)
+{
+    mt19937 generator(19);
+    vector<int> keys(n);
+    for (int &key : keys)
+    {
+        key = (int)(generator() >> 1);
+    }
+
+    PersistentBST tree;
+    auto start = chrono::steady_clock::now();
+    for (int key : keys)
+    {
+        tree = tree.insert(key);
+    }
+    auto end = chrono::steady_clock::now();
+    cout << "Built " << tree.count() << " random keys with path copying in "
+         << chrono::duration<double, milli>(end - start).count() << " ms, height " << tree.height() << endl;
+
+    // Sorted keys would build a chain without rebalancing
+    PersistentBST sorted;
+    start = chrono::steady_clock::now();
+    for (int key = 0; key < n; key++)
+    {
+        sorted = sorted.insert(key);
+    }
+    end = chrono::steady_clock::now();
+    cout << "Built " << sorted.count() << " ascending keys with path copying in "
+         << chrono::duration<double, milli>(end - start).count() << " ms, height " << sorted.height() << endl;
+
+    start = chrono::steady_clock::now();
+    PersistentBST snapshot = tree;
+    end = chrono::steady_clock::now();
+    cout << "Snapshot:  " << chrono::duration<double, micro>(end - start).count() << " us" << endl;
+
+    start = chrono::steady_clock::now();
+    PersistentBST copy = tree.deepCopy();
+    end = chrono::steady_clock::now();
+    cout << "Deep copy: " << chrono::duration<double, micro>(end - start).count() << " us" << endl;
+
+    // Keep inserting; the snapshot must not see the new keys
+    int before = snapshot.count();
+    for (int i = 0; i < 1000; i++)
+    {
+        tree = tree.insert(-1 - i);
+    }
+    bool unchanged = snapshot.count() == before && !snapshot.search(-1) && tree.search(-1);
+    cout << "Snapshot " << (unchanged ? "unchanged" : "CHANGED") << " after 1000 more inserts" << endl;
+    return unchanged ? 0 : 1;
+}
+
+/**
+ * @brief Main function to demonstrate the persistent Binary Search Tree
+ * @param argc Number of command-line arguments
+ * @param argv Pass --benchmark [n] to time building the tree and compare snapshots with deep copies instead
+ * @return int Exit status of the program
+ */
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && string(argv[1]) == "--benchmark")
+    {
+        return runBenchmark(argc > 2 ? atoi(argv[2]) : 1000000);
+    }
+
+    // Create a tree; each insert returns the next version
+    PersistentBST tree;
+    tree = tree.insert(50).insert(30).insert(20).insert(40).insert(70).insert(60).insert(80);
+
+    // Take a snapshot, then keep inserting into the live tree
+    PersistentBST snapshot = tree;
+    tree = tree.insert(35).insert(65);
+
+    cout << "In-order traversal of the snapshot: ";
+    snapshot.inOrder();
+    cout << "In-order traversal of the live tree: ";
+    tree.inOrder();
+
+    // Demonstrate search functionality in both versions
+    int valueToSearch = 35;
+    cout << valueToSearch << (snapshot.search(valueToSearch) ? " found" : " not found") << " in the snapshot, "
+         << (tree.search(valueToSearch) ? "found" : "not found") << " in the live tree." << endl;
+
+    // Inserting a key that is already present returns the same version
+    cout << "Inserting 50 again " << (tree.insert(50).sharesRootWith(tree) ? "shares" : "copies") << " the root."
+         << endl;
+
+    return 0;
+}
+
+/**
+ * Usage Instructions:
+ * 1. Compile the program using a C++ compiler (e.g., g++ -O2 persistent_bst.cpp -o persistent_bst)
+ * 2. Run the compiled executable (e.g., ./persistent_bst)
+ * 3. The program will display a snapshot and the live tree after more inserts
+ *
+ * To time random and ascending builds and compare snapshots with deep copies, run ./persistent_bst --benchmark [n]
+ *
+ * To use the tree in your own code:
+ * 1. Include the PersistentNode struct and PersistentBST class in your program
+ * 2. Replace a version with tree = tree.insert(value); copy a PersistentBST to take a snapshot
+ */
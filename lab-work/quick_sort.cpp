@@ -6,85 +6,306 @@
  * along with helper functions for swapping elements, partitioning the array,
  * and printing the array. It also includes a main function to demonstrate
  * the usage of the Quick Sort algorithm.
+ *
+ * Besides the classic Lomuto quickSort, the file provides introSort, a
+ * production sort mode that stays O(n log n) on sorted, reversed and
+ * duplicate-heavy input and never recurses deeper than O(log n).
+ *
+ * introSort finishes subarrays of up to 64 elements with the vectorized
+ * sorting network from sorting_network.h when the CPU supports AVX2 or
+ * AVX-512, and with insertion sort otherwise.
+ *
+ * quickSort can also use blockPartition, a branchless BlockQuicksort-style
+ * partition kernel. Running the program with --benchmark compares the two
+ * kernels on random, sorted and few-unique input.
+ *
+ * For order statistics the file provides quickSelect (introselect: the
+ * partition function in a quickselect loop, with a median-of-medians
+ * fallback that keeps the worst case linear), partialSort for the k smallest
+ * elements in order, and TopK, a bounded heap for the k largest values of a
+ * stream. Running the program with --select compares them with a full sort.
+ *
+ * The sorts themselves live in quick_sort.h, namespace quick_sort, which
+ * parallel_quick_sort.h and sort_benchmark.cpp include too; this file
+ * holds the demo and the benchmarks.
  */
 
+#include "quick_sort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 using namespace std;
+using namespace quick_sort;
+
+/**
+ * @brief Checks whether an array is sorted in ascending order
+ * @param arr The array to be checked
+ * @param n The number of elements in the array
+ * @return true if the array is sorted, false otherwise
+ */
+bool isSorted(int arr[], int n)
+{
+    for (int i = 1; i < n; i++)
+    {
+        if (arr[i] < arr[i - 1])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Prints the elements of an array
+ * @param arr The array to be printed
+ * @param n The number of elements in the array
+ */
+void printArray(int arr[], int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        cout << arr[i] << " ";
+    }
+    cout << endl;
+}
 
 /**
- * @brief Swaps two integer values
- * @param a Reference to the first integer
- * @param b Reference to the second integer
+ * @brief Opens a hardware counter for branch mispredictions of this thread
+ * @return A file descriptor for the counter, or -1 if it is unavailable
  */
-void swap(int &a, int &b)
+int openBranchMissCounter()
 {
-    int temp = a;
-    a = b;
-    b = temp;
+#ifdef __linux__
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
 }
 
 /**
- * @brief Partitions the array and returns the pivot index
- * @param arr The array to be partitioned
- * @param low The starting index of the partition
- * @param high The ending index of the partition
- * @return The index of the pivot element after partitioning
+ * @brief Counts branch mispredictions and time of one partition kernel run
+ * @param data The input, whose median is used as the pivot
+ * @param scheme The partition kernel to run
+ * @param counterFd The branch-miss counter from openBranchMissCounter, or -1
+ * @param misses Set to the number of mispredicted branches, or -1 if unavailable
+ * @return The elapsed time in nanoseconds
  */
-int partition(int arr[], int low, int high)
+double timePartition(const vector<int> &data, PartitionScheme scheme, int counterFd, long long &misses)
 {
-    int pivot = arr[high]; // Choose the rightmost element as pivot
-    int i = low - 1;       // Index of smaller element
+    vector<int> arr(data);
+    int n = (int)arr.size();
+
+    // Move the median to the end so both kernels split the input evenly
+    vector<int> copy(data);
+    nth_element(copy.begin(), copy.begin() + n / 2, copy.end());
+    int medianIndex = (int)(find(arr.begin(), arr.end(), copy[n / 2]) - arr.begin());
+    swap(arr[medianIndex], arr[n - 1]);
 
-    for (int j = low; j < high; j++)
+    misses = -1;
+#ifdef __linux__
+    if (counterFd >= 0)
+    {
+        ioctl(counterFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counterFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    auto start = chrono::steady_clock::now();
+    int pi = scheme == BLOCK_PARTITION ? blockPartition(arr.data(), 0, n - 1) : partition(arr.data(), 0, n - 1);
+    auto end = chrono::steady_clock::now();
+#ifdef __linux__
+    if (counterFd >= 0)
     {
-        if (arr[j] < pivot)
+        ioctl(counterFd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counterFd, &misses, sizeof(misses)) != (ssize_t)sizeof(misses))
         {
-            i++;                  // Increment index of smaller element
-            swap(arr[i], arr[j]); // Swap elements
+            misses = -1;
         }
     }
-    swap(arr[i + 1], arr[high]); // Place the pivot in its correct position
-    return i + 1;                // Return the partitioning index
+#endif
+
+    // Sanity check so a broken kernel cannot report a good time
+    for (int i = 0; i < n; i++)
+    {
+        if ((i < pi && !(arr[i] < arr[pi])) || (i > pi && arr[i] < arr[pi]))
+        {
+            cout << "Partition check failed at index " << i << endl;
+            exit(1);
+        }
+    }
+    return chrono::duration<double, nano>(end - start).count();
 }
 
 /**
- * @brief Implements the Quick Sort algorithm
- * @param arr The array to be sorted
- * @param low The starting index of the array or subarray
- * @param high The ending index of the array or subarray
+ * @brief Compares the Lomuto and block partition kernels
+ * @param n The number of elements per input
+ * @return 0 on successful execution
+ *
+ * Prints ns/element and branch mispredictions/element for one partition
+ * pass over random, sorted and few-unique input. Full sorts are not timed
+ * because both kernels take arr[high] as the pivot, which is quadratic on
+ * sorted and few-unique input; introSort is the mode to use there.
  */
-void quickSort(int arr[], int low, int high)
+int runPartitionBenchmark(int n)
 {
-    if (low < high)
+    mt19937 generator(2024);
+    vector<int> random(n), sorted(n), fewUnique(n);
+    for (int i = 0; i < n; i++)
+    {
+        random[i] = (int)generator();
+        sorted[i] = i;
+        fewUnique[i] = (int)(generator() % 16);
+    }
+
+    int counterFd = openBranchMissCounter();
+    if (counterFd < 0)
+    {
+        cout << "Branch-miss counter unavailable; reporting time only." << endl;
+    }
+
+    const char *names[] = {"random", "sorted", "few-unique"};
+    const vector<int> *inputs[] = {&random, &sorted, &fewUnique};
+
+    cout << "input\tkernel\tns/elem\tmisses/elem" << endl;
+    for (int d = 0; d < 3; d++)
     {
-        int pi = partition(arr, low, high); // Get the partition index
+        for (PartitionScheme scheme : {LOMUTO_PARTITION, BLOCK_PARTITION})
+        {
+            long long misses;
+            double ns = timePartition(*inputs[d], scheme, counterFd, misses);
+            cout << names[d] << "\t" << (scheme == BLOCK_PARTITION ? "block" : "lomuto") << "\t" << ns / n << "\t";
+            if (misses >= 0)
+            {
+                cout << (double)misses / n;
+            }
+            else
+            {
+                cout << "n/a";
+            }
+            cout << endl;
+        }
+    }
 
-        // Recursively sort elements before and after partition
-        quickSort(arr, low, pi - 1);
-        quickSort(arr, pi + 1, high);
+#ifdef __linux__
+    if (counterFd >= 0)
+    {
+        close(counterFd);
     }
+#endif
+    return 0;
 }
 
 /**
- * @brief Prints the elements of an array
- * @param arr The array to be printed
- * @param n The number of elements in the array
+ * @brief Compares full sorting with the selection functions for a top-k query
+ * @param n The number of random elements
+ * @param k The number of elements wanted
+ * @return 0 if every method found the same k values, 1 otherwise
+ *
+ * Times introSort of the whole input against partialSort, quickSelect and
+ * the streaming TopK on random input, plus quickSelect on sorted and
+ * all-equal input, where a plain quickselect would be quadratic.
  */
-void printArray(int arr[], int n)
+int runSelectionBenchmark(int n, int k)
 {
+    mt19937 generator(7);
+    vector<int> input(n);
+    for (int &x : input)
+    {
+        x = (int)generator();
+    }
+    k = max(1, min(k, n));
+
+    auto timeMs = [](auto function)
+    {
+        auto start = chrono::steady_clock::now();
+        function();
+        auto end = chrono::steady_clock::now();
+        return chrono::duration<double, milli>(end - start).count();
+    };
+
+    // Reference: the k smallest values from a full sort
+    vector<int> sorted(input);
+    double sortMs = timeMs([&]() { introSort(sorted.data(), n); });
+
+    vector<int> partial(input);
+    double partialMs = timeMs([&]() { partialSort(partial.data(), n, k); });
+
+    vector<int> selected(input);
+    double selectMs = timeMs([&]() { quickSelect(selected.data(), n, k - 1); });
+
+    // The k largest values of the stream, pushed one at a time
+    TopK top(k);
+    double topMs = timeMs(
+        [&]()
+        {
+            for (int x : input)
+            {
+                top.push(x);
+            }
+        });
+
+    bool correct = equal(sorted.begin(), sorted.begin() + k, partial.begin()) && selected[k - 1] == sorted[k - 1];
+    vector<int> largest = top.values();
+    correct = correct && equal(largest.begin(), largest.end(), sorted.rbegin());
+
+    cout << "Top " << k << " of " << n << " random ints:" << endl;
+    cout << "introSort (full sort):  " << sortMs << " ms" << endl;
+    cout << "partialSort:            " << partialMs << " ms" << endl;
+    cout << "quickSelect:            " << selectMs << " ms" << endl;
+    cout << "TopK (streaming heap):  " << topMs << " ms" << endl;
+
+    // Inputs that defeat a plain quickselect with a fixed pivot
+    vector<int> ascending(n), equalKeys(n, 42);
     for (int i = 0; i < n; i++)
     {
-        cout << arr[i] << " ";
+        ascending[i] = i;
     }
-    cout << endl;
+    double ascendingMs = timeMs([&]() { quickSelect(ascending.data(), n, n / 2); });
+    double equalMs = timeMs([&]() { quickSelect(equalKeys.data(), n, n / 2); });
+    correct = correct && ascending[n / 2] == n / 2 && equalKeys[n / 2] == 42;
+    cout << "quickSelect median, sorted input:    " << ascendingMs << " ms" << endl;
+    cout << "quickSelect median, all-equal input: " << equalMs << " ms" << endl;
+    cout << "Results " << (correct ? "agree" : "DISAGREE") << " with the full sort" << endl;
+    return correct ? 0 : 1;
 }
 
 /**
  * @brief Main function to demonstrate the Quick Sort algorithm
+ * @param argc The number of command-line arguments
+ * @param argv Pass --benchmark [n] to compare the partition kernels, or
+ *             --select [n] [k] to compare the selection functions, instead
  * @return 0 on successful execution
  */
-int main()
+int main(int argc, char *argv[])
 {
+    if (argc > 1 && string(argv[1]) == "--benchmark")
+    {
+        return runPartitionBenchmark(argc > 2 ? atoi(argv[2]) : 10000000);
+    }
+    if (argc > 1 && string(argv[1]) == "--select")
+    {
+        return runSelectionBenchmark(argc > 2 ? atoi(argv[2]) : 10000000, argc > 3 ? atoi(argv[3]) : 1000);
+    }
+
     // Initialize the array to be sorted
     int arr[] = {10, 7, 8, 9, 1, 5};
     int n = sizeof(arr) / sizeof(arr[0]);
@@ -100,6 +321,54 @@ int main()
     cout << "Sorted array: ";
     printArray(arr, n);
 
+    // Sort the same input using the block partition kernel
+    int arr1[] = {10, 7, 8, 9, 1, 5};
+    quickSort(arr1, 0, n - 1, BLOCK_PARTITION);
+    cout << "Sorted with block partition: ";
+    printArray(arr1, n);
+
+    // Sort the same input using introSort
+    int arr2[] = {10, 7, 8, 9, 1, 5};
+    introSort(arr2, n);
+    cout << "Sorted with introSort: ";
+    printArray(arr2, n);
+
+    // Already-sorted and all-duplicate inputs make quickSort quadratic and
+    // overflow its stack; introSort handles them in O(n log n)
+    const int bigN = 1000000;
+    vector<int> sortedInput(bigN);
+    vector<int> duplicateInput(bigN, 42);
+    for (int i = 0; i < bigN; i++)
+    {
+        sortedInput[i] = i;
+    }
+
+    introSort(sortedInput.data(), bigN);
+    introSort(duplicateInput.data(), bigN);
+    cout << "introSort on " << bigN << " sorted elements: "
+         << (isSorted(sortedInput.data(), bigN) ? "sorted" : "NOT sorted") << endl;
+    cout << "introSort on " << bigN << " equal elements: "
+         << (isSorted(duplicateInput.data(), bigN) ? "sorted" : "NOT sorted") << endl;
+
+    // Order statistics without sorting everything
+    int arr3[] = {10, 7, 8, 9, 1, 5};
+    quickSelect(arr3, n, n / 2);
+    cout << "Median (element of rank " << n / 2 << ") by quickSelect: " << arr3[n / 2] << endl;
+
+    int arr4[] = {10, 7, 8, 9, 1, 5};
+    partialSort(arr4, n, 3);
+    cout << "Three smallest by partialSort: ";
+    printArray(arr4, 3);
+
+    TopK top(2);
+    for (int x : {10, 7, 8, 9, 1, 5})
+    {
+        top.push(x);
+    }
+    vector<int> largest = top.values();
+    cout << "Two largest by TopK: ";
+    printArray(largest.data(), (int)largest.size());
+
     return 0;
 }
 
@@ -110,7 +379,21 @@ int main()
  * 3. The program will display the original array and the sorted array
  *
  * To use the Quick Sort algorithm in your own code:
- * 1. Include the necessary functions (quickSort, partition, and swap) in your program
- * 2. Call the quickSort function with your array, starting index (0), and ending index (n-1)
- *    Example: quickSort(your_array, 0, array_size - 1);
+ * 1. #include "quick_sort.h", and keep sorting_network.h and sorting_network_kernel.h next to it
+ * 2. Call quickSort with your array, starting index (0), and ending index (n-1)
+ *    Example: quick_sort::quickSort(your_array, 0, array_size - 1);
+ * 3. To use the branchless kernel, pass BLOCK_PARTITION
+ *    Example: quick_sort::quickSort(your_array, 0, array_size - 1, quick_sort::BLOCK_PARTITION);
+ *
+ * To compare the partition kernels, run ./quick_sort --benchmark [n]
+ *
+ * For order statistics and top-k queries without a full sort:
+ * 1. quickSelect(your_array, array_size, k) puts the k-th smallest (0-based) at index k
+ * 2. partialSort(your_array, array_size, k) sorts the k smallest into the first k slots
+ * 3. TopK keeps the k largest values of a stream: create TopK top(k), call top.push(value)
+ *    for each value, then top.values() returns them largest first
+ * To compare them with a full sort, run ./quick_sort --select [n] [k]
+ *
+ * For production workloads (sorted, reversed or duplicate-heavy input) use introSort:
+ *    Example: quick_sort::introSort(your_array, array_size);
  */
@@ -0,0 +1,712 @@
+/**
+ * @file quick_sort.h
+ * @brief Header-only int-array quicksort kernels: quickSort, introSort and the selection functions
+ *
+ * The kernels of quick_sort.cpp, kept in a header so that
+ * parallel_quick_sort.h and sort_benchmark.cpp run the same code as the
+ * demo. Everything is in namespace quick_sort:
+ *
+ * - quickSort with the classic Lomuto partition or blockPartition, a
+ *   branchless BlockQuicksort-style kernel
+ * - introSort: ninther pivots, three-way partitioning, a heap sort fallback
+ *   and sorting-network leaves from sorting_network.h
+ * - quickSelect, partialSort and TopK for order statistics
+ *
+ * Requires C++17.
+ */
+
+#ifndef QUICK_SORT_H
+#define QUICK_SORT_H
+
+#include "sorting_network.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace quick_sort
+{
+
+const int INSERTION_SORT_THRESHOLD = 16; ///< Subarrays this small are finished by insertion sort
+const int NINTHER_THRESHOLD = 128;       ///< Subarrays larger than this use a ninther pivot
+const int PARTITION_BLOCK_SIZE = 128;    ///< Elements classified per block by blockPartition
+const int MEDIAN_GROUP_SIZE = 5;         ///< Group size of the median-of-medians pivot
+
+/**
+ * @enum PartitionScheme
+ * @brief Selects the partition kernel used by quickSort
+ */
+enum PartitionScheme
+{
+    LOMUTO_PARTITION, ///< The classic partition function
+    BLOCK_PARTITION   ///< The branchless blockPartition function
+};
+
+/**
+ * @brief Swaps two integer values
+ * @param a Reference to the first integer
+ * @param b Reference to the second integer
+ */
+inline void swap(int &a, int &b)
+{
+    int temp = a;
+    a = b;
+    b = temp;
+}
+
+/**
+ * @brief Partitions the array and returns the pivot index
+ * @param arr The array to be partitioned
+ * @param low The starting index of the partition
+ * @param high The ending index of the partition
+ * @return The index of the pivot element after partitioning
+ */
+inline int partition(int arr[], int low, int high)
+{
+    int pivot = arr[high]; // Choose the rightmost element as pivot
+    int i = low - 1;       // Index of smaller element
+
+    for (int j = low; j < high; j++)
+    {
+        if (arr[j] < pivot)
+        {
+            i++;                  // Increment index of smaller element
+            swap(arr[i], arr[j]); // Swap elements
+        }
+    }
+    swap(arr[i + 1], arr[high]); // Place the pivot in its correct position
+    return i + 1;                // Return the partitioning index
+}
+
+/**
+ * @brief Partitions the array without data-dependent branches
+ *
+ * Same contract as partition: arr[high] is the pivot and its final index is
+ * returned. The kernel scans a block of elements from each end and records
+ * the offsets of misplaced elements by adding the comparison result to a
+ * counter instead of branching on it. The recorded pairs are then swapped
+ * in a loop whose trip count does not depend on individual comparisons, so
+ * the branch predictor has nothing to mispredict on random data.
+ *
+ * @param arr The array to be partitioned
+ * @param low The starting index of the partition
+ * @param high The ending index of the partition
+ * @return The index of the pivot element after partitioning
+ */
+inline int blockPartition(int arr[], int low, int high)
+{
+    int pivot = arr[high];
+    int left = low;       // First element not yet known to be < pivot
+    int right = high - 1; // Last element not yet known to be >= pivot
+
+    unsigned char offsetsLeft[PARTITION_BLOCK_SIZE];  // Elements >= pivot in the left block
+    unsigned char offsetsRight[PARTITION_BLOCK_SIZE]; // Elements < pivot in the right block
+    int startLeft = 0, numLeft = 0;
+    int startRight = 0, numRight = 0;
+
+    while (right - left + 1 >= 2 * PARTITION_BLOCK_SIZE)
+    {
+        // Refill whichever buffer has been used up
+        if (numLeft == 0)
+        {
+            startLeft = 0;
+            for (int i = 0; i < PARTITION_BLOCK_SIZE; i++)
+            {
+                offsetsLeft[numLeft] = (unsigned char)i;
+                numLeft += !(arr[left + i] < pivot);
+            }
+        }
+        if (numRight == 0)
+        {
+            startRight = 0;
+            for (int i = 0; i < PARTITION_BLOCK_SIZE; i++)
+            {
+                offsetsRight[numRight] = (unsigned char)i;
+                numRight += arr[right - i] < pivot;
+            }
+        }
+
+        // Swap misplaced pairs across the two blocks
+        int num = std::min(numLeft, numRight);
+        for (int k = 0; k < num; k++)
+        {
+            swap(arr[left + offsetsLeft[startLeft + k]], arr[right - offsetsRight[startRight + k]]);
+        }
+        numLeft -= num;
+        numRight -= num;
+        startLeft += num;
+        startRight += num;
+
+        // A block with no misplaced elements left is done
+        if (numLeft == 0)
+        {
+            left += PARTITION_BLOCK_SIZE;
+        }
+        if (numRight == 0)
+        {
+            right -= PARTITION_BLOCK_SIZE;
+        }
+    }
+
+    // Fewer than two blocks remain: finish them with the Lomuto scheme
+    int i = left - 1;
+    for (int j = left; j <= right; j++)
+    {
+        if (arr[j] < pivot)
+        {
+            i++;
+            swap(arr[i], arr[j]);
+        }
+    }
+    swap(arr[i + 1], arr[high]);
+    return i + 1;
+}
+
+/**
+ * @brief Implements the Quick Sort algorithm
+ * @param arr The array to be sorted
+ * @param low The starting index of the array or subarray
+ * @param high The ending index of the array or subarray
+ * @param scheme The partition kernel to use (Lomuto by default)
+ */
+inline void quickSort(int arr[], int low, int high, PartitionScheme scheme = LOMUTO_PARTITION)
+{
+    if (low < high)
+    {
+        // Get the partition index
+        int pi = scheme == BLOCK_PARTITION ? blockPartition(arr, low, high) : partition(arr, low, high);
+
+        // Recursively sort elements before and after partition
+        quickSort(arr, low, pi - 1, scheme);
+        quickSort(arr, pi + 1, high, scheme);
+    }
+}
+
+/**
+ * @brief Performs insertion sort on an array
+ *
+ * Same routine as in insertion_sort.cpp. introSort uses it to finish small
+ * subarrays, where it is faster than partitioning any further.
+ *
+ * @param arr The array to be sorted
+ * @param n The number of elements in the array
+ */
+inline void insertionSort(int arr[], int n)
+{
+    for (int i = 1; i < n; i++)
+    {
+        int key = arr[i]; // The element to be inserted
+        int j = i - 1;
+
+        // Move elements of arr[0..i-1] that are greater than key
+        // to one position ahead of their current position
+        while (j >= 0 && arr[j] > key)
+        {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key; // Insert the key at the correct position
+    }
+}
+
+/**
+ * @brief Moves arr[root] down the max-heap until the heap property holds
+ * @param arr The array holding the heap
+ * @param root The index of the element to sift down
+ * @param n The number of elements in the heap
+ */
+inline void siftDown(int arr[], int root, int n)
+{
+    int value = arr[root];
+    int child = 2 * root + 1;
+
+    while (child < n)
+    {
+        // Pick the larger of the two children
+        if (child + 1 < n && arr[child] < arr[child + 1])
+        {
+            child++;
+        }
+        if (!(value < arr[child]))
+        {
+            break;
+        }
+        arr[root] = arr[child]; // Move the child up one level
+        root = child;
+        child = 2 * root + 1;
+    }
+    arr[root] = value;
+}
+
+/**
+ * @brief Sorts an array with heap sort
+ *
+ * Used by introSort as a fallback when partitioning keeps producing
+ * unbalanced splits, which guarantees O(n log n) in the worst case.
+ *
+ * @param arr The array to be sorted
+ * @param n The number of elements in the array
+ */
+inline void heapSort(int arr[], int n)
+{
+    // Build a max-heap bottom-up
+    for (int i = n / 2 - 1; i >= 0; i--)
+    {
+        siftDown(arr, i, n);
+    }
+
+    // Repeatedly move the maximum to the end of the unsorted part
+    for (int end = n - 1; end > 0; end--)
+    {
+        swap(arr[0], arr[end]);
+        siftDown(arr, 0, end);
+    }
+}
+
+/**
+ * @brief Returns the index of the median of three array elements
+ * @param arr The array containing the elements
+ * @param a Index of the first element
+ * @param b Index of the second element
+ * @param c Index of the third element
+ * @return The index holding the median value
+ */
+inline int medianOfThree(int arr[], int a, int b, int c)
+{
+    if (arr[a] < arr[b])
+    {
+        if (arr[b] < arr[c])
+        {
+            return b;
+        }
+        return arr[a] < arr[c] ? c : a;
+    }
+    if (arr[a] < arr[c])
+    {
+        return a;
+    }
+    return arr[b] < arr[c] ? c : b;
+}
+
+/**
+ * @brief Chooses a pivot index for the subarray arr[low..high]
+ *
+ * Small subarrays use the median of the first, middle and last elements.
+ * Larger ones use Tukey's ninther (the median of three medians of three),
+ * which resists sorted, reversed and organ-pipe inputs.
+ *
+ * @param arr The array being sorted
+ * @param low The starting index of the subarray
+ * @param high The ending index of the subarray
+ * @return The index of the chosen pivot
+ */
+inline int choosePivot(int arr[], int low, int high)
+{
+    int n = high - low + 1;
+    int mid = low + n / 2;
+
+    if (n <= NINTHER_THRESHOLD)
+    {
+        return medianOfThree(arr, low, mid, high);
+    }
+
+    int step = n / 8;
+    int first = medianOfThree(arr, low, low + step, low + 2 * step);
+    int middle = medianOfThree(arr, mid - step, mid, mid + step);
+    int last = medianOfThree(arr, high - 2 * step, high - step, high);
+    return medianOfThree(arr, first, middle, last);
+}
+
+/**
+ * @brief Three-way (Dutch national flag) partition around a given pivot value
+ *
+ * Rearranges arr[low..high] into three bands: elements less than the pivot,
+ * elements equal to it, and elements greater than it. Keys equal to the
+ * pivot are placed once and never looked at again, so inputs with many
+ * duplicates are sorted in linear time per distinct key.
+ *
+ * @param arr The array to be partitioned
+ * @param low The starting index of the partition
+ * @param high The ending index of the partition
+ * @param pivot The pivot value, taken from arr[low..high]
+ * @param lt Set to the first index of the band equal to the pivot
+ * @param gt Set to the last index of the band equal to the pivot
+ */
+inline void partition3WayAround(int arr[], int low, int high, int pivot, int &lt, int &gt)
+{
+    int i = low;
+    lt = low;
+    gt = high;
+
+    while (i <= gt)
+    {
+        if (arr[i] < pivot)
+        {
+            swap(arr[lt++], arr[i++]); // Grow the "less" band
+        }
+        else if (pivot < arr[i])
+        {
+            swap(arr[i], arr[gt--]); // Grow the "greater" band, recheck arr[i]
+        }
+        else
+        {
+            i++; // Equal to the pivot, leave it in the middle band
+        }
+    }
+}
+
+/**
+ * @brief Three-way partition around a median-of-three or ninther pivot
+ * @param arr The array to be partitioned
+ * @param low The starting index of the partition
+ * @param high The ending index of the partition
+ * @param lt Set to the first index of the band equal to the pivot
+ * @param gt Set to the last index of the band equal to the pivot
+ */
+inline void partition3Way(int arr[], int low, int high, int &lt, int &gt)
+{
+    partition3WayAround(arr, low, high, arr[choosePivot(arr, low, high)], lt, gt);
+}
+
+/**
+ * @brief Core loop of introSort on the subarray arr[low..high]
+ *
+ * Recurses only into the smaller side of each partition and loops on the
+ * larger one, so the stack depth is bounded by log2(n). When depthLimit
+ * reaches zero the subarray is handed to heapSort. Subarrays small enough
+ * for the sorting network (or insertion sort, without SIMD) end the loop.
+ *
+ * @param arr The array to be sorted
+ * @param low The starting index of the subarray
+ * @param high The ending index of the subarray
+ * @param depthLimit The number of partitioning levels left before falling back to heap sort
+ */
+inline void introSortLoop(int arr[], int low, int high, int depthLimit)
+{
+    bool useNetwork = sorting::sortingNetworkAvailable();
+    int leafSize = useNetwork ? (int)sorting::SORTING_NETWORK_MAX : INSERTION_SORT_THRESHOLD;
+
+    while (high - low + 1 > leafSize)
+    {
+        if (depthLimit == 0)
+        {
+            heapSort(arr + low, high - low + 1);
+            return;
+        }
+        depthLimit--;
+
+        int lt, gt;
+        partition3Way(arr, low, high, lt, gt);
+
+        // Recurse into the smaller side, continue the loop with the larger side
+        if (lt - low < high - gt)
+        {
+            introSortLoop(arr, low, lt - 1, depthLimit);
+            low = gt + 1;
+        }
+        else
+        {
+            introSortLoop(arr, gt + 1, high, depthLimit);
+            high = lt - 1;
+        }
+    }
+
+    if (low < high)
+    {
+        if (useNetwork)
+        {
+            sorting::sortingNetworkSort(arr + low, (std::size_t)(high - low + 1));
+        }
+        else
+        {
+            insertionSort(arr + low, high - low + 1);
+        }
+    }
+}
+
+/**
+ * @brief Sorts an array with introsort
+ *
+ * Quicksort with median-of-three/ninther pivots and three-way partitioning,
+ * a sorting network (or insertion sort) for small subarrays, and a heap sort
+ * fallback once the recursion depth exceeds 2*log2(n).
+ *
+ * @param arr The array to be sorted
+ * @param n The number of elements in the array
+ *
+ * @note Time Complexity: O(n log n) in the worst case.
+ * @note Space Complexity: O(log n) stack.
+ */
+inline void introSort(int arr[], int n)
+{
+    int log2n = 0;
+    for (int size = n; size > 1; size >>= 1)
+    {
+        log2n++;
+    }
+    introSortLoop(arr, 0, n - 1, 2 * log2n);
+}
+
+/**
+ * @brief Median-of-medians pivot value for arr[low..high]
+ *
+ * Moves the median of every group of five to the front of the subarray and
+ * selects the median of those medians with medianOfMediansSelect. At least
+ * 30% of the subarray is guaranteed to lie on each side of the result.
+ *
+ * @param arr The array being selected in
+ * @param low The starting index of the subarray, which has more than INSERTION_SORT_THRESHOLD elements
+ * @param high The ending index of the subarray
+ * @return The pivot value
+ */
+inline int medianOfMediansPivot(int arr[], int low, int high);
+
+/**
+ * @brief Deterministic linear-time selection (Blum-Floyd-Pratt-Rivest-Tarjan)
+ *
+ * Rearranges arr[low..high] so that arr[k] holds the value it would have if
+ * the subarray were sorted, with no larger value before it and no smaller
+ * value after it. Three-way partitioning around the median-of-medians pivot
+ * removes a constant fraction of the subarray per step even with duplicates.
+ *
+ * @param arr The array to select in
+ * @param low The starting index of the subarray
+ * @param high The ending index of the subarray
+ * @param k The index to select, low <= k <= high
+ *
+ * @note Time Complexity: O(n) in the worst case.
+ */
+inline void medianOfMediansSelect(int arr[], int low, int high, int k)
+{
+    while (high - low + 1 > INSERTION_SORT_THRESHOLD)
+    {
+        int lt, gt;
+        partition3WayAround(arr, low, high, medianOfMediansPivot(arr, low, high), lt, gt);
+        if (k < lt)
+        {
+            high = lt - 1;
+        }
+        else if (k > gt)
+        {
+            low = gt + 1;
+        }
+        else
+        {
+            return;
+        }
+    }
+    insertionSort(arr + low, high - low + 1);
+}
+
+inline int medianOfMediansPivot(int arr[], int low, int high)
+{
+    int groups = (high - low + 1) / MEDIAN_GROUP_SIZE;
+    for (int g = 0; g < groups; g++)
+    {
+        int groupLow = low + g * MEDIAN_GROUP_SIZE;
+        insertionSort(arr + groupLow, MEDIAN_GROUP_SIZE);
+        swap(arr[low + g], arr[groupLow + MEDIAN_GROUP_SIZE / 2]);
+    }
+
+    int middle = low + groups / 2;
+    medianOfMediansSelect(arr, low, low + groups - 1, middle);
+    return arr[middle];
+}
+
+/**
+ * @brief Rearranges an array so that arr[k] is its k-th smallest element (introselect)
+ *
+ * Quickselect with ninther pivots and the partition function of quickSort,
+ * continuing only into the side that contains k. After the call no element
+ * before arr[k] is larger than it and no element after it is smaller, like
+ * std::nth_element. If two partitioning steps fail to halve the subarray
+ * (sorted-adversarial input, many duplicates) the search switches to the
+ * median-of-medians selection, so the worst case stays linear.
+ *
+ * @param arr The array to select in
+ * @param n The number of elements in the array
+ * @param k The 0-based rank to select; out-of-range values leave the array unchanged
+ *
+ * @note Time Complexity: O(n) expected and in the worst case.
+ */
+inline void quickSelect(int arr[], int n, int k)
+{
+    if (k < 0 || k >= n)
+    {
+        return;
+    }
+
+    int low = 0;
+    int high = n - 1;
+    int sizeTwoStepsAgo = n;
+    int steps = 0;
+
+    while (high - low + 1 > INSERTION_SORT_THRESHOLD)
+    {
+        if (++steps % 2 == 0)
+        {
+            if (high - low + 1 > sizeTwoStepsAgo / 2)
+            {
+                medianOfMediansSelect(arr, low, high, k);
+                return;
+            }
+            sizeTwoStepsAgo = high - low + 1;
+        }
+
+        // Move the ninther to arr[high], where partition expects its pivot
+        swap(arr[choosePivot(arr, low, high)], arr[high]);
+        int pi = partition(arr, low, high);
+        if (k < pi)
+        {
+            high = pi - 1;
+        }
+        else if (k > pi)
+        {
+            low = pi + 1;
+        }
+        else
+        {
+            return;
+        }
+    }
+    insertionSort(arr + low, high - low + 1);
+}
+
+/**
+ * @brief Sorts the k smallest elements of an array into arr[0..k-1]
+ *
+ * Selects the k-th smallest element with quickSelect, which leaves the k
+ * smallest elements in front of it, then sorts only those with introSort.
+ * The order of the remaining elements is unspecified.
+ *
+ * @param arr The array to be partially sorted
+ * @param n The number of elements in the array
+ * @param k The number of smallest elements wanted in sorted order
+ *
+ * @note Time Complexity: O(n + k log k).
+ */
+inline void partialSort(int arr[], int n, int k)
+{
+    if (k >= n)
+    {
+        introSort(arr, n);
+        return;
+    }
+    if (k <= 0)
+    {
+        return;
+    }
+    quickSelect(arr, n, k - 1);
+    introSort(arr, k - 1);
+}
+
+/**
+ * @class TopK
+ * @brief Keeps the k largest values of a stream in a bounded min-heap
+ *
+ * The root of the heap is the smallest of the values kept, so a new value
+ * only enters the heap if it beats the root, replacing it. Once the heap is
+ * warm most values are rejected with a single comparison, and memory stays
+ * at k ints no matter how long the stream is, so the input never needs to
+ * be held in memory at once.
+ *
+ * @note Time Complexity: O(n log k) worst case for n values, close to O(n) on random streams.
+ * @note Space Complexity: O(k).
+ */
+class TopK
+{
+private:
+    int k;            ///< The number of values kept
+    std::vector<int> heap; ///< Min-heap of the largest values seen so far
+
+    /**
+     * @brief Restores the min-heap property downwards from index root
+     */
+    void siftDownMin(int root)
+    {
+        int size = (int)heap.size();
+        int value = heap[root];
+        while (2 * root + 1 < size)
+        {
+            int child = 2 * root + 1;
+            if (child + 1 < size && heap[child + 1] < heap[child])
+            {
+                child++;
+            }
+            if (!(heap[child] < value))
+            {
+                break;
+            }
+            heap[root] = heap[child];
+            root = child;
+        }
+        heap[root] = value;
+    }
+
+    /**
+     * @brief Restores the min-heap property upwards from index i
+     */
+    void siftUpMin(int i)
+    {
+        int value = heap[i];
+        while (i > 0 && value < heap[(i - 1) / 2])
+        {
+            heap[i] = heap[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        heap[i] = value;
+    }
+
+public:
+    /**
+     * @brief Creates an empty top-k tracker
+     * @param count The number of largest values to keep
+     */
+    explicit TopK(int count) : k(count < 0 ? 0 : count)
+    {
+        heap.reserve(k);
+    }
+
+    /**
+     * @brief Offers one value from the stream
+     * @param value The value
+     */
+    void push(int value)
+    {
+        if ((int)heap.size() < k)
+        {
+            heap.push_back(value);
+            siftUpMin((int)heap.size() - 1);
+        }
+        else if (k > 0 && heap[0] < value)
+        {
+            heap[0] = value;
+            siftDownMin(0);
+        }
+    }
+
+    /**
+     * @brief Returns the smallest value kept, the threshold a new value must beat
+     * @return The root of the heap; only valid if at least one value was pushed
+     */
+    int threshold() const
+    {
+        return heap[0];
+    }
+
+    /**
+     * @brief Returns the values kept, largest first
+     * @return Up to k values in descending order
+     */
+    std::vector<int> values() const
+    {
+        std::vector<int> result(heap);
+        introSort(result.data(), (int)result.size());
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+};
+
+} // namespace quick_sort
+
+#endif // QUICK_SORT_H
@@ -0,0 +1,119 @@
+/**
+ * @file radix_sort.cpp
+ * @brief Implementation of LSD and MSD (American flag) Radix Sort for integer keys
+ *
+ * This file contains two radix sorts for 32-bit and 64-bit signed integers,
+ * along with helper functions and a main function to demonstrate their usage.
+ * Both sort on 8-bit digits, so a 32-bit key needs at most 4 passes and a
+ * 64-bit key at most 8, regardless of the number of elements.
+ *
+ * - radixSort is a least-significant-digit sort. It builds the histograms of
+ *   every digit in a single read of the input, then scatters back and forth
+ *   between the array and one scratch buffer of the same size. Passes whose
+ *   digit is the same for every key are skipped.
+ * - americanFlagSort is an in-place most-significant-digit sort for when the
+ *   scratch buffer cannot be afforded. It permutes each bucket into place by
+ *   following cycles and recurses into buckets on the next digit.
+ *
+ * The sorts themselves live in radix_sort.h, namespace radix_sort, which
+ * sort_benchmark.cpp includes too; this file holds the demo.
+ */
+
+#include "radix_sort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+using namespace std;
+using namespace radix_sort;
+
+/**
+ * @brief Prints the elements of an array
+ * @param arr The array to be printed
+ * @param n The number of elements in the array
+ */
+void printArray(int arr[], int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        cout << arr[i] << " ";
+    }
+    cout << endl;
+}
+
+/**
+ * @brief Times one sort of a copy of the input and checks it against std::sort
+ * @param name The label to print
+ * @param input The unsorted input
+ * @param sortFunction The sort to run
+ */
+template <typename T>
+void timeSort(const char *name, const vector<T> &input, void (*sortFunction)(T[], int))
+{
+    vector<T> expected(input);
+    sort(expected.begin(), expected.end());
+
+    vector<T> arr(input);
+    auto start = chrono::steady_clock::now();
+    sortFunction(arr.data(), (int)arr.size());
+    auto end = chrono::steady_clock::now();
+
+    cout << name << ": " << chrono::duration<double, milli>(end - start).count() << " ms, "
+         << (arr == expected ? "correct" : "WRONG") << endl;
+}
+
+/**
+ * @brief Main function to demonstrate the radix sorts
+ * @return 0 on successful execution
+ */
+int main()
+{
+    // Sample array including negative numbers
+    int arr[] = {170, -45, 75, 90, -802, 24, 2, 66};
+    int n = sizeof(arr) / sizeof(arr[0]);
+
+    cout << "Original array: ";
+    printArray(arr, n);
+
+    radixSort(arr, n);
+    cout << "Sorted with radixSort: ";
+    printArray(arr, n);
+
+    int arr2[] = {170, -45, 75, 90, -802, 24, 2, 66};
+    americanFlagSort(arr2, n);
+    cout << "Sorted with americanFlagSort: ";
+    printArray(arr2, n);
+
+    // Larger inputs: 32-bit keys and 64-bit IDs
+    const int bigN = 5000000;
+    mt19937_64 generator(7);
+    vector<int> keys(bigN);
+    vector<long long> ids(bigN);
+    for (int i = 0; i < bigN; i++)
+    {
+        keys[i] = (int)generator();
+        ids[i] = (long long)generator();
+    }
+
+    cout << endl << "Sorting " << bigN << " random keys" << endl;
+    timeSort<int>("radixSort (32-bit)", keys, radixSort);
+    timeSort<int>("americanFlagSort (32-bit)", keys, americanFlagSort);
+    timeSort<long long>("radixSort (64-bit)", ids, radixSort);
+    timeSort<long long>("americanFlagSort (64-bit)", ids, americanFlagSort);
+
+    return 0;
+}
+
+/**
+ * @note Usage Instructions:
+ * 1. Compile the program using a C++ compiler (e.g., g++ -O2 radix_sort.cpp -o radix_sort)
+ * 2. Run the compiled executable (e.g., ./radix_sort)
+ * 3. The program sorts a small sample with both sorts, then times them on 5M random keys
+ *
+ * @note To use the radix sorts in your own code:
+ * 1. #include "radix_sort.h"
+ * 2. Call radix_sort::radixSort(your_array, array_size) or radix_sort::americanFlagSort(your_array, array_size);
+ *    both accept int and long long arrays
+ */
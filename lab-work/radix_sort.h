@@ -0,0 +1,263 @@
+/**
+ * @file radix_sort.h
+ * @brief Header-only LSD and MSD (American flag) radix sorts for int and long long arrays
+ *
+ * The kernels of radix_sort.cpp, kept in a header so that sort_benchmark.cpp
+ * runs the same code as the demo. Everything is in namespace radix_sort:
+ * radixSort is the buffered least-significant-digit sort and
+ * americanFlagSort the in-place most-significant-digit one, both on 8-bit
+ * digits.
+ */
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace radix_sort
+{
+
+const int RADIX_BITS = 8;                     ///< Bits per digit
+const int RADIX = 1 << RADIX_BITS;            ///< Number of buckets per digit
+const int AMERICAN_FLAG_INSERTION_CUTOFF = 32; ///< Buckets this small are finished by insertion sort
+
+/**
+ * @brief Maps a signed key to an unsigned key with the same ordering
+ *
+ * Flipping the sign bit moves negative numbers below positive ones when the
+ * bits are compared as an unsigned number.
+ *
+ * @param value The signed key
+ * @return The order-preserving unsigned key
+ */
+template <typename Signed, typename Unsigned>
+Unsigned radixKey(Signed value)
+{
+    const Unsigned signBit = (Unsigned)1 << (8 * sizeof(Signed) - 1);
+    return (Unsigned)value ^ signBit;
+}
+
+/**
+ * @brief LSD radix sort shared by the 32-bit and 64-bit entry points
+ * @param arr The array to be sorted
+ * @param n The number of elements in the array
+ */
+template <typename Signed, typename Unsigned>
+void lsdRadixSort(Signed arr[], int n)
+{
+    const int passes = (int)sizeof(Signed);
+    if (n < 2)
+    {
+        return;
+    }
+
+    // Histogram of every digit, gathered in one pass over the input
+    std::vector<int> counts(passes * RADIX, 0);
+    for (int i = 0; i < n; i++)
+    {
+        Unsigned key = radixKey<Signed, Unsigned>(arr[i]);
+        for (int d = 0; d < passes; d++)
+        {
+            counts[d * RADIX + (int)((key >> (d * RADIX_BITS)) & (RADIX - 1))]++;
+        }
+    }
+
+    std::vector<Signed> buffer(n);
+    Signed *src = arr;
+    Signed *dst = buffer.data();
+
+    for (int d = 0; d < passes; d++)
+    {
+        int *count = &counts[d * RADIX];
+        int shift = d * RADIX_BITS;
+
+        // Every key has the same digit here, so the pass would not move anything
+        Unsigned firstKey = radixKey<Signed, Unsigned>(src[0]);
+        if (count[(firstKey >> shift) & (RADIX - 1)] == n)
+        {
+            continue;
+        }
+
+        // Exclusive prefix sum turns counts into bucket start offsets
+        int offsets[RADIX];
+        int sum = 0;
+        for (int b = 0; b < RADIX; b++)
+        {
+            offsets[b] = sum;
+            sum += count[b];
+        }
+
+        // Stable scatter into the other buffer
+        for (int i = 0; i < n; i++)
+        {
+            Unsigned key = radixKey<Signed, Unsigned>(src[i]);
+            dst[offsets[(key >> shift) & (RADIX - 1)]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    // An odd number of non-trivial passes leaves the result in the buffer
+    if (src != arr)
+    {
+        std::copy(src, src + n, arr);
+    }
+}
+
+/**
+ * @brief Sorts an array of 32-bit integers with LSD radix sort
+ *
+ * @param arr The array to be sorted
+ * @param n The number of elements in the array
+ *
+ * @note Time Complexity: O(n) with at most 4 scatter passes.
+ * @note Space Complexity: O(n) for the scratch buffer.
+ */
+inline void radixSort(int arr[], int n)
+{
+    lsdRadixSort<int, unsigned int>(arr, n);
+}
+
+/**
+ * @brief Sorts an array of 64-bit integers with LSD radix sort
+ *
+ * @param arr The array to be sorted
+ * @param n The number of elements in the array
+ *
+ * @note Time Complexity: O(n) with at most 8 scatter passes.
+ * @note Space Complexity: O(n) for the scratch buffer.
+ */
+inline void radixSort(long long arr[], int n)
+{
+    lsdRadixSort<long long, unsigned long long>(arr, n);
+}
+
+/**
+ * @brief Insertion sort used by americanFlagSort for small buckets
+ * @param arr The array to be sorted
+ * @param n The number of elements in the array
+ */
+template <typename Signed>
+void insertionSort(Signed arr[], int n)
+{
+    for (int i = 1; i < n; i++)
+    {
+        Signed key = arr[i];
+        int j = i - 1;
+        while (j >= 0 && arr[j] > key)
+        {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+/**
+ * @brief Sorts arr[0..n-1] on the digit at shift and recurses on lower digits
+ * @param arr The array to be sorted
+ * @param n The number of elements in the array
+ * @param shift The bit position of the current digit
+ */
+template <typename Signed, typename Unsigned>
+void americanFlagSortRange(Signed arr[], int n, int shift)
+{
+    while (true)
+    {
+        if (n <= AMERICAN_FLAG_INSERTION_CUTOFF)
+        {
+            insertionSort(arr, n);
+            return;
+        }
+
+        int counts[RADIX] = {0};
+        for (int i = 0; i < n; i++)
+        {
+            counts[(radixKey<Signed, Unsigned>(arr[i]) >> shift) & (RADIX - 1)]++;
+        }
+
+        // Every key has the same digit here: move straight on to the next one
+        if (counts[(radixKey<Signed, Unsigned>(arr[0]) >> shift) & (RADIX - 1)] == n)
+        {
+            if (shift == 0)
+            {
+                return;
+            }
+            shift -= RADIX_BITS;
+            continue;
+        }
+
+        int starts[RADIX], next[RADIX];
+        int sum = 0;
+        for (int b = 0; b < RADIX; b++)
+        {
+            starts[b] = sum;
+            next[b] = sum;
+            sum += counts[b];
+        }
+
+        // Permute in place: carry each misplaced key to the next free slot of
+        // its bucket, picking up the key found there, until the cycle closes
+        for (int b = 0; b < RADIX; b++)
+        {
+            int end = starts[b] + counts[b];
+            while (next[b] < end)
+            {
+                Signed value = arr[next[b]];
+                int digit = (int)((radixKey<Signed, Unsigned>(value) >> shift) & (RADIX - 1));
+                while (digit != b)
+                {
+                    std::swap(value, arr[next[digit]++]);
+                    digit = (int)((radixKey<Signed, Unsigned>(value) >> shift) & (RADIX - 1));
+                }
+                arr[next[b]++] = value;
+            }
+        }
+
+        if (shift == 0)
+        {
+            return;
+        }
+        for (int b = 0; b < RADIX; b++)
+        {
+            if (counts[b] > 1)
+            {
+                americanFlagSortRange<Signed, Unsigned>(arr + starts[b], counts[b], shift - RADIX_BITS);
+            }
+        }
+        return;
+    }
+}
+
+/**
+ * @brief Sorts an array of 32-bit integers in place with American flag sort
+ *
+ * @param arr The array to be sorted
+ * @param n The number of elements in the array
+ *
+ * @note Time Complexity: O(n) per digit level, at most 4 levels.
+ * @note Space Complexity: O(1) besides the per-level bucket tables on the stack.
+ */
+inline void americanFlagSort(int arr[], int n)
+{
+    americanFlagSortRange<int, unsigned int>(arr, n, 8 * (int)sizeof(int) - RADIX_BITS);
+}
+
+/**
+ * @brief Sorts an array of 64-bit integers in place with American flag sort
+ *
+ * @param arr The array to be sorted
+ * @param n The number of elements in the array
+ *
+ * @note Time Complexity: O(n) per digit level, at most 8 levels.
+ * @note Space Complexity: O(1) besides the per-level bucket tables on the stack.
+ */
+inline void americanFlagSort(long long arr[], int n)
+{
+    americanFlagSortRange<long long, unsigned long long>(arr, n, 8 * (int)sizeof(long long) - RADIX_BITS);
+}
+
+} // namespace radix_sort
+
+#endif // RADIX_SORT_H
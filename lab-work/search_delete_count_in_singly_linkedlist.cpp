@@ -5,8 +5,21 @@
  * This file contains functions to perform search, deletion, and counting operations
  * on a singly linked list. It includes functions to search for a value, delete nodes
  * from different positions, and count the total number of nodes in the list.
+ *
+ * The list keeps a pointer to its last node and its length, so counting
+ * takes O(1). Deleting the last node still walks the list: a singly linked
+ * node has no link back to the node that becomes the new tail.
+ *
+ * Nodes come from a NodePool (node_pool.h), as in linked_list_insertion.cpp,
+ * so the delete functions hand them back with nodePool.destroy rather than
+ * delete. Create the nodes of a list with nodePool.create(value, nullptr).
  */
 
+#include "node_pool.h"
+
+#include <iostream>
+using namespace std;
+
 /**
  * @struct Node
  * @brief Represents a node in the singly linked list
@@ -20,16 +33,31 @@ struct Node
     Node *next;
 };
 
+/**
+ * @struct SinglyLinkedList
+ * @brief The ends and length of a singly linked list
+ *
+ * An empty list has null head and tail pointers and a size of 0.
+ */
+struct SinglyLinkedList
+{
+    Node *head = nullptr; ///< Pointer to the first node
+    Node *tail = nullptr; ///< Pointer to the last node
+    int size = 0;         ///< Number of nodes in the list
+};
+
+NodePool<Node> nodePool; ///< Allocates the nodes of every list in this program; freed at exit
+
 /**
  * @brief Searches for a value in the linked list
  *
- * @param head Pointer to the head of the linked list
+ * @param list The linked list
  * @param value The value to search for
  * @return true if the value is found, false otherwise
  */
-bool search(Node *head, int value)
+bool search(const SinglyLinkedList &list, int value)
 {
-    Node *temp = head;
+    Node *temp = list.head;
     while (temp != nullptr)
     {
         if (temp->data == value)
@@ -44,19 +72,24 @@ bool search(Node *head, int value)
 /**
  * @brief Deletes the first node of the linked list
  *
- * @param head Reference to the pointer to the head of the linked list
+ * @param list Reference to the linked list
  */
-void deleteFirst(Node *&head)
+void deleteFirst(SinglyLinkedList &list)
 {
-    if (head == nullptr)
+    if (list.head == nullptr)
     {
         cout << "List is empty." << endl;
         return;
     }
 
-    Node *temp = head;
-    head = head->next;
-    delete temp;
+    Node *temp = list.head;
+    list.head = list.head->next;
+    if (list.head == nullptr)
+    {
+        list.tail = nullptr;
+    }
+    list.size--;
+    nodePool.destroy(temp);
 
     cout << "Deleted the first node." << endl;
 }
@@ -64,32 +97,37 @@ void deleteFirst(Node *&head)
 /**
  * @brief Deletes the last node of the linked list
  *
- * @param head Reference to the pointer to the head of the linked list
+ * @param list Reference to the linked list
+ *
+ * @note O(n): the node before the tail can only be found from the head.
  */
-void deleteLast(Node *&head)
+void deleteLast(SinglyLinkedList &list)
 {
-    if (head == nullptr)
+    if (list.head == nullptr)
     {
         cout << "List is empty." << endl;
         return;
     }
 
-    if (head->next == nullptr)
+    if (list.head == list.tail)
     { // If there's only one node
-        delete head;
-        head = nullptr;
+        nodePool.destroy(list.head);
+        list.head = list.tail = nullptr;
+        list.size = 0;
         cout << "Deleted the last node." << endl;
         return;
     }
 
-    Node *temp = head;
-    while (temp->next->next != nullptr)
+    Node *temp = list.head;
+    while (temp->next != list.tail)
     {
         temp = temp->next;
     }
 
-    delete temp->next;
+    nodePool.destroy(list.tail);
     temp->next = nullptr;
+    list.tail = temp;
+    list.size--;
 
     cout << "Deleted the last node." << endl;
 }
@@ -97,28 +135,33 @@ void deleteLast(Node *&head)
 /**
  * @brief Deletes a specific node with the given value from the linked list
  *
- * @param head Reference to the pointer to the head of the linked list
+ * @param list Reference to the linked list
  * @param value The value of the node to be deleted
  */
-void deleteSpecific(Node *&head, int value)
+void deleteSpecific(SinglyLinkedList &list, int value)
 {
-    if (head == nullptr)
+    if (list.head == nullptr)
     {
         cout << "List is empty." << endl;
         return;
     }
 
     // If the node to be deleted is the head node
-    if (head->data == value)
+    if (list.head->data == value)
     {
-        Node *temp = head;
-        head = head->next;
-        delete temp;
+        Node *temp = list.head;
+        list.head = list.head->next;
+        if (list.head == nullptr)
+        {
+            list.tail = nullptr;
+        }
+        list.size--;
+        nodePool.destroy(temp);
         cout << "Deleted node with value " << value << "." << endl;
         return;
     }
 
-    Node *temp = head;
+    Node *temp = list.head;
     while (temp->next != nullptr && temp->next->data != value)
     {
         temp = temp->next;
@@ -132,7 +175,12 @@ void deleteSpecific(Node *&head, int value)
 
     Node *nodeToDelete = temp->next;
     temp->next = temp->next->next;
-    delete nodeToDelete;
+    if (nodeToDelete == list.tail)
+    {
+        list.tail = temp;
+    }
+    list.size--;
+    nodePool.destroy(nodeToDelete);
 
     cout << "Deleted node with value " << value << "." << endl;
 }
@@ -140,19 +188,12 @@ void deleteSpecific(Node *&head, int value)
 /**
  * @brief Counts the total number of nodes in the linked list
  *
- * @param head Pointer to the head of the linked list
- * @return The number of nodes in the linked list
+ * @param list The linked list
+ * @return The number of nodes in the linked list, kept up to date by every operation: O(1)
  */
-int countNodes(Node *head)
+int countNodes(const SinglyLinkedList &list)
 {
-    int count = 0;
-    Node *temp = head;
-    while (temp != nullptr)
-    {
-        count++;
-        temp = temp->next;
-    }
-    return count;
+    return list.size;
 }
 
 /**
@@ -0,0 +1,766 @@
+/**
+ * @file sort_benchmark.cpp
+ * @brief Benchmark harness for the sorting algorithms over standard input distributions
+ *
+ * The demo programs of the individual sorts sort a handful of hard-coded
+ * elements, which says nothing about performance. This program runs every
+ * sort of the lab (through the templated versions in generic_sort.h, which
+ * implement the same algorithms as the int-array files) over sizes from 10 to
+ * 10^8 and over the usual input distributions:
+ *
+ * - uniform:     independent random ints
+ * - sorted:      already ascending
+ * - reverse:     descending
+ * - organ-pipe:  ascending to the middle, then descending
+ * - few-unique:  16 distinct values
+ * - zipf:        Zipf-distributed values (exponent 1), a few very frequent keys
+ *
+ * For each combination it reports:
+ * - ns/element: the best of several timed runs on plain ints
+ * - comparisons, swaps and moves per element: counted in a separate run with
+ *   an instrumented element type, so counting does not distort the timing
+ * - cache misses and branch misses per element: from the hardware counters
+ *   through perf_event_open on Linux, during the timed runs; -1 where the
+ *   counters are unavailable (other systems, containers, perf_event_paranoid)
+ *
+ * The int-array kernels that exist only in the individual files are run
+ * too, so a regression in them shows up here: the block-partition quickSort
+ * and the sorting-network-leaf introSort of quick_sort.h, parallelQuickSort
+ * of parallel_quick_sort.h on every hardware thread, and radixSort and
+ * americanFlagSort of radix_sort.h. They take int arrays only, so their
+ * comparisons, swaps and moves are not counted (-1).
+ *
+ * Results are printed as a table and can be written as CSV and/or JSON for
+ * regression tracking. The O(n^2) sorts, and quickSort with its last-element
+ * pivot on any non-uniform input, are only run up to --max-quadratic elements.
+ */
+
+#include "generic_sort.h"
+#include "parallel_quick_sort.h"
+#include "quick_sort.h"
+#include "radix_sort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const long long DEFAULT_MIN_SIZE = 10;             ///< Smallest size benchmarked by default
+const long long DEFAULT_MAX_SIZE = 1000000;        ///< Largest size benchmarked by default
+const long long DEFAULT_MAX_QUADRATIC = 10000;     ///< Largest size for the O(n^2) cases by default
+const long long BATCH_ELEMENTS = 1 << 16;          ///< Small inputs are sorted in batches of about this many elements
+const double MIN_MEASURE_SECONDS = 0.05;           ///< Timed runs are repeated until they take this long
+const int MIN_TRIALS = 3;                          ///< ... and at least this many times
+const int FEW_UNIQUE_VALUES = 16;                  ///< Distinct values of the few-unique distribution
+const int ZIPF_MAX_RANKS = 1000000;                ///< Distinct values of the Zipf distribution, at most
+
+/**
+ * @enum SortId
+ * @brief The benchmarked sorts
+ */
+enum SortId
+{
+    BUBBLE_SORT,
+    INSERTION_SORT,
+    SELECTION_SORT,
+    QUICK_SORT,
+    QUICK_SORT_BLOCK,
+    HEAP_SORT,
+    INTRO_SORT,
+    TIM_SORT,
+    RADIX_SORT,
+    QUICK_SORT_BLOCK_INT, ///< quickSort with BLOCK_PARTITION from quick_sort.h
+    INTRO_SORT_INT,       ///< introSort from quick_sort.h, with sorting-network leaves where available
+    PARALLEL_QUICK_SORT,  ///< parallelQuickSort from parallel_quick_sort.h
+    RADIX_SORT_INT,       ///< radixSort from radix_sort.h
+    AMERICAN_FLAG_SORT,   ///< americanFlagSort from radix_sort.h
+    STD_SORT,
+    SORT_COUNT
+};
+
+/// Names used on the command line and in the output, indexed by SortId
+const char *SORT_NAMES[SORT_COUNT] = {"bubble",         "insertion",       "selection", "quick",
+                                      "quick-block",    "heap",            "intro",     "tim",
+                                      "radix",          "quick-block-int", "intro-int", "parallel-quick",
+                                      "radix-int",      "american-flag",   "std::sort"};
+
+/**
+ * @enum Distribution
+ * @brief The input distributions
+ */
+enum Distribution
+{
+    UNIFORM,
+    SORTED,
+    REVERSE,
+    ORGAN_PIPE,
+    FEW_UNIQUE,
+    ZIPF,
+    DISTRIBUTION_COUNT
+};
+
+/// Names used on the command line and in the output, indexed by Distribution
+const char *DISTRIBUTION_NAMES[DISTRIBUTION_COUNT] = {"uniform", "sorted", "reverse", "organ-pipe", "few-unique", "zipf"};
+
+/**
+ * @struct OperationCounts
+ * @brief Operations counted by the instrumented run
+ */
+struct OperationCounts
+{
+    long long comparisons = 0; ///< Calls of the comparator
+    long long swaps = 0;       ///< Element swaps
+    long long moves = 0;       ///< Element copies and moves outside of swaps
+};
+
+/// The counters incremented by CountedInt and the counting comparator
+OperationCounts operationCounts;
+
+/**
+ * @struct CountedInt
+ * @brief An int that counts how often it is moved and swapped
+ */
+struct CountedInt
+{
+    int value = 0;
+
+    CountedInt() = default;
+    CountedInt(int v) : value(v) {}
+    CountedInt(const CountedInt &other) : value(other.value) { operationCounts.moves++; }
+
+    CountedInt &operator=(const CountedInt &other)
+    {
+        value = other.value;
+        operationCounts.moves++;
+        return *this;
+    }
+
+    friend void swap(CountedInt &a, CountedInt &b)
+    {
+        operationCounts.swaps++;
+        int temp = a.value;
+        a.value = b.value;
+        b.value = temp;
+    }
+};
+
+/**
+ * @struct Result
+ * @brief One row of the benchmark output; -1 marks an unavailable measurement
+ */
+struct Result
+{
+    string sort;               ///< Name of the sort
+    string distribution;       ///< Name of the input distribution
+    long long n;               ///< Number of elements
+    double nsPerElement;       ///< Best time per element
+    double comparisons;        ///< Comparisons per element
+    double swaps;              ///< Swaps per element
+    double moves;              ///< Moves per element
+    double cacheMisses;        ///< Hardware cache misses per element
+    double branchMisses;       ///< Mispredicted branches per element
+};
+
+/**
+ * @brief Runs one sort on a range
+ * @param id The sort to run
+ * @param comp The comparator on projected keys
+ * @param proj The projection from elements to int keys
+ */
+template <typename RandomIt, typename Compare, typename Projection>
+void runSort(SortId id, RandomIt first, RandomIt last, Compare comp, Projection proj)
+{
+    switch (id)
+    {
+    case BUBBLE_SORT:
+        sorting::bubbleSort(first, last, comp, proj);
+        break;
+    case INSERTION_SORT:
+        sorting::insertionSort(first, last, comp, proj);
+        break;
+    case SELECTION_SORT:
+        sorting::selectionSort(first, last, comp, proj);
+        break;
+    case QUICK_SORT:
+        sorting::quickSort(first, last, sorting::PartitionScheme::Lomuto, comp, proj);
+        break;
+    case QUICK_SORT_BLOCK:
+        sorting::quickSort(first, last, sorting::PartitionScheme::Block, comp, proj);
+        break;
+    case HEAP_SORT:
+        sorting::heapSort(first, last, comp, proj);
+        break;
+    case INTRO_SORT:
+        sorting::introSort(first, last, comp, proj);
+        break;
+    case TIM_SORT:
+        sorting::timSort(first, last, comp, proj);
+        break;
+    case RADIX_SORT:
+        sorting::radixSort(first, last, proj);
+        break;
+    default:
+        sort(first, last, [&](const auto &a, const auto &b) { return comp(invoke(proj, a), invoke(proj, b)); });
+        break;
+    }
+}
+
+/**
+ * @brief Whether a sort is one of the int-array kernels of quick_sort.h, parallel_quick_sort.h and radix_sort.h
+ */
+bool isIntArraySort(SortId id)
+{
+    return id == QUICK_SORT_BLOCK_INT || id == INTRO_SORT_INT || id == PARALLEL_QUICK_SORT || id == RADIX_SORT_INT ||
+           id == AMERICAN_FLAG_SORT;
+}
+
+/**
+ * @brief Runs one of the int-array kernels on arr[0..n)
+ * @param id The sort to run; isIntArraySort(id) must be true
+ */
+void runIntArraySort(SortId id, int arr[], int n)
+{
+    switch (id)
+    {
+    case QUICK_SORT_BLOCK_INT:
+        quick_sort::quickSort(arr, 0, n - 1, quick_sort::BLOCK_PARTITION);
+        break;
+    case INTRO_SORT_INT:
+        quick_sort::introSort(arr, n);
+        break;
+    case PARALLEL_QUICK_SORT:
+        parallel_quick_sort::parallelQuickSort(arr, n, (int)max(1u, thread::hardware_concurrency()));
+        break;
+    case RADIX_SORT_INT:
+        radix_sort::radixSort(arr, n);
+        break;
+    default:
+        radix_sort::americanFlagSort(arr, n);
+        break;
+    }
+}
+
+/**
+ * @brief Whether a sort is run on the given input only up to --max-quadratic elements
+ */
+bool isQuadraticCase(SortId id, Distribution distribution)
+{
+    if (id == BUBBLE_SORT || id == INSERTION_SORT || id == SELECTION_SORT)
+    {
+        return true;
+    }
+    // The last-element pivot degrades on every structured or duplicate-heavy input
+    return (id == QUICK_SORT || id == QUICK_SORT_BLOCK || id == QUICK_SORT_BLOCK_INT) && distribution != UNIFORM;
+}
+
+/**
+ * @brief Generates an input of the given distribution
+ * @param distribution The distribution
+ * @param n The number of elements
+ * @param seed The random seed, so every sort sees the same input
+ * @return The input
+ */
+vector<int> makeInput(Distribution distribution, long long n, unsigned int seed)
+{
+    mt19937 generator(seed);
+    vector<int> arr((size_t)n);
+
+    switch (distribution)
+    {
+    case SORTED:
+    case REVERSE:
+        for (long long i = 0; i < n; i++)
+        {
+            arr[i] = (int)(distribution == SORTED ? i : n - 1 - i);
+        }
+        break;
+    case ORGAN_PIPE:
+        for (long long i = 0; i < n; i++)
+        {
+            arr[i] = (int)(i < n / 2 ? i : n - 1 - i);
+        }
+        break;
+    case FEW_UNIQUE:
+        for (int &x : arr)
+        {
+            x = (int)(generator() % FEW_UNIQUE_VALUES);
+        }
+        break;
+    case ZIPF:
+    {
+        // Inverse-CDF sampling: value k (1-based rank) has probability proportional to 1/k
+        int ranks = (int)min<long long>(n, ZIPF_MAX_RANKS);
+        vector<double> cdf(ranks);
+        double sum = 0;
+        for (int k = 0; k < ranks; k++)
+        {
+            sum += 1.0 / (k + 1);
+            cdf[k] = sum;
+        }
+        uniform_real_distribution<double> uniform(0.0, sum);
+        for (int &x : arr)
+        {
+            x = (int)(upper_bound(cdf.begin(), cdf.end() - 1, uniform(generator)) - cdf.begin());
+        }
+        break;
+    }
+    default:
+        for (int &x : arr)
+        {
+            x = (int)generator();
+        }
+        break;
+    }
+    return arr;
+}
+
+/**
+ * @enum HardwareEvent
+ * @brief The hardware events counted during the timed runs
+ */
+enum HardwareEvent
+{
+    CACHE_MISSES,  ///< Last-level cache misses
+    BRANCH_MISSES  ///< Mispredicted branches
+};
+
+/**
+ * @brief Opens a hardware event counter for this thread
+ * @param event The event to count
+ * @return The counter's file descriptor, or -1 if unavailable
+ */
+int openHardwareCounter(HardwareEvent event)
+{
+#ifdef __linux__
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = event == CACHE_MISSES ? PERF_COUNT_HW_CACHE_MISSES : PERF_COUNT_HW_BRANCH_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    (void)event;
+    return -1;
+#endif
+}
+
+/**
+ * @brief Resets and starts a counter opened by openHardwareCounter
+ */
+void startCounter(int fd)
+{
+#ifdef __linux__
+    if (fd >= 0)
+    {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    (void)fd;
+#endif
+}
+
+/**
+ * @brief Stops a counter and reads it
+ * @return The event count since startCounter, or -1 if unavailable
+ */
+long long stopCounter(int fd)
+{
+    long long value = -1;
+#ifdef __linux__
+    if (fd >= 0)
+    {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &value, sizeof(value)) != (ssize_t)sizeof(value))
+        {
+            value = -1;
+        }
+    }
+#else
+    (void)fd;
+#endif
+    return value;
+}
+
+/**
+ * @brief Times a sort on plain ints and reads the hardware counters
+ * @param id The sort
+ * @param input The input
+ * @param cacheFd The cache-miss counter, or -1
+ * @param branchFd The branch-miss counter, or -1
+ * @param result Receives the time and counter values
+ * @return false if the sort produced unsorted output
+ */
+bool timeSort(SortId id, const vector<int> &input, int cacheFd, int branchFd, Result &result)
+{
+    long long n = (long long)input.size();
+    long long batch = max<long long>(1, BATCH_ELEMENTS / max<long long>(n, 1));
+    vector<int> work((size_t)(batch * n));
+
+    double best = 1e300;
+    double elapsed = 0;
+    long long cacheMisses = 0;
+    long long branchMisses = 0;
+    int trials = 0;
+    bool sorted = true;
+
+    // Large inputs take long enough to time once
+    int minTrials = n >= 10000000 ? 1 : MIN_TRIALS;
+    while (trials < minTrials || elapsed < MIN_MEASURE_SECONDS)
+    {
+        for (long long b = 0; b < batch; b++)
+        {
+            copy(input.begin(), input.end(), work.begin() + b * n);
+        }
+
+        startCounter(cacheFd);
+        startCounter(branchFd);
+        auto start = chrono::steady_clock::now();
+        for (long long b = 0; b < batch; b++)
+        {
+            if (isIntArraySort(id))
+            {
+                runIntArraySort(id, work.data() + b * n, (int)n);
+            }
+            else
+            {
+                runSort(id, work.begin() + b * n, work.begin() + (b + 1) * n, less<int>(), sorting::Identity());
+            }
+        }
+        auto end = chrono::steady_clock::now();
+        long long cache = stopCounter(cacheFd);
+        long long branch = stopCounter(branchFd);
+
+        double seconds = chrono::duration<double>(end - start).count();
+        best = min(best, seconds);
+        elapsed += seconds;
+        cacheMisses = cache < 0 || cacheMisses < 0 ? -1 : cacheMisses + cache;
+        branchMisses = branch < 0 || branchMisses < 0 ? -1 : branchMisses + branch;
+        trials++;
+
+        sorted = sorted && is_sorted(work.begin(), work.end() - (batch - 1) * n);
+    }
+
+    double elements = (double)(batch * n);
+    result.nsPerElement = best * 1e9 / elements;
+    result.cacheMisses = cacheMisses < 0 ? -1 : (double)cacheMisses / (elements * trials);
+    result.branchMisses = branchMisses < 0 ? -1 : (double)branchMisses / (elements * trials);
+    return sorted;
+}
+
+/**
+ * @brief Counts the comparisons, swaps and moves of one sort run
+ * @param id The sort; not one of the int-array kernels, which cannot be instrumented
+ * @param input The input
+ * @param result Receives the counts per element
+ */
+void countOperations(SortId id, const vector<int> &input, Result &result)
+{
+    vector<CountedInt> arr(input.begin(), input.end());
+    operationCounts = OperationCounts();
+    runSort(
+        id, arr.begin(), arr.end(),
+        [](int a, int b)
+        {
+            operationCounts.comparisons++;
+            return a < b;
+        },
+        &CountedInt::value);
+
+    double n = (double)max<size_t>(input.size(), 1);
+    result.comparisons = operationCounts.comparisons / n;
+    result.swaps = operationCounts.swaps / n;
+    result.moves = operationCounts.moves / n;
+}
+
+/**
+ * @brief Formats a measurement, printing -1 for unavailable values
+ */
+string formatValue(double value)
+{
+    ostringstream out;
+    if (value < 0)
+    {
+        out << -1;
+    }
+    else
+    {
+        out << setprecision(4) << value;
+    }
+    return out.str();
+}
+
+/**
+ * @brief Writes the results as CSV
+ * @return false if the file could not be written
+ */
+bool writeCsv(const string &path, const vector<Result> &results)
+{
+    ofstream out(path);
+    out << "sort,distribution,n,ns_per_element,comparisons_per_element,swaps_per_element,moves_per_element,"
+           "cache_misses_per_element,branch_misses_per_element\n";
+    for (const Result &r : results)
+    {
+        out << r.sort << "," << r.distribution << "," << r.n << "," << formatValue(r.nsPerElement) << ","
+            << formatValue(r.comparisons) << "," << formatValue(r.swaps) << "," << formatValue(r.moves) << ","
+            << formatValue(r.cacheMisses) << "," << formatValue(r.branchMisses) << "\n";
+    }
+    return (bool)out;
+}
+
+/**
+ * @brief Writes the results as a JSON array of objects
+ * @return false if the file could not be written
+ */
+bool writeJson(const string &path, const vector<Result> &results)
+{
+    ofstream out(path);
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const Result &r = results[i];
+        out << "  {\"sort\": \"" << r.sort << "\", \"distribution\": \"" << r.distribution << "\", \"n\": " << r.n
+            << ", \"ns_per_element\": " << formatValue(r.nsPerElement)
+            << ", \"comparisons_per_element\": " << formatValue(r.comparisons)
+            << ", \"swaps_per_element\": " << formatValue(r.swaps)
+            << ", \"moves_per_element\": " << formatValue(r.moves)
+            << ", \"cache_misses_per_element\": " << formatValue(r.cacheMisses)
+            << ", \"branch_misses_per_element\": " << formatValue(r.branchMisses) << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+    return (bool)out;
+}
+
+/**
+ * @brief Parses a comma-separated list of names against a table of known names
+ * @param list The comma-separated names, or "all"
+ * @param names The known names
+ * @param count The number of known names
+ * @param selected Receives the indices of the selected names
+ * @return false if a name is unknown
+ */
+bool parseSelection(const string &list, const char *const names[], int count, vector<int> &selected)
+{
+    selected.clear();
+    if (list == "all")
+    {
+        for (int i = 0; i < count; i++)
+        {
+            selected.push_back(i);
+        }
+        return true;
+    }
+
+    stringstream stream(list);
+    string name;
+    while (getline(stream, name, ','))
+    {
+        int index = (int)(find(names, names + count, name) - names);
+        if (index == count)
+        {
+            cout << "Unknown name: " << name << endl;
+            return false;
+        }
+        selected.push_back(index);
+    }
+    return true;
+}
+
+/**
+ * @brief Prints the command-line options
+ */
+void printUsage(const char *program)
+{
+    cout << "Usage: " << program << " [options]" << endl
+         << "  --min-size N          smallest input size (default " << DEFAULT_MIN_SIZE << ")" << endl
+         << "  --max-size N          largest input size, up to 100000000 (default " << DEFAULT_MAX_SIZE << ")" << endl
+         << "  --max-quadratic N     largest size for O(n^2) cases (default " << DEFAULT_MAX_QUADRATIC << ")" << endl
+         << "  --sorts a,b,...       sorts to run (default all):";
+    for (const char *name : SORT_NAMES)
+    {
+        cout << " " << name;
+    }
+    cout << endl << "  --distributions a,... distributions to use (default all):";
+    for (const char *name : DISTRIBUTION_NAMES)
+    {
+        cout << " " << name;
+    }
+    cout << endl
+         << "  --no-counts           skip counting comparisons, swaps and moves" << endl
+         << "  --csv FILE            also write the results as CSV" << endl
+         << "  --json FILE           also write the results as JSON" << endl;
+}
+
+/**
+ * @brief Main function to run the benchmark
+ * @param argc Number of command-line arguments
+ * @param argv The options, see printUsage
+ * @return 0 on success, 1 on a bad option or an incorrectly sorted output
+ */
+int main(int argc, char *argv[])
+{
+    long long minSize = DEFAULT_MIN_SIZE;
+    long long maxSize = DEFAULT_MAX_SIZE;
+    long long maxQuadratic = DEFAULT_MAX_QUADRATIC;
+    vector<int> sorts;
+    vector<int> distributions;
+    bool counts = true;
+    string csvPath;
+    string jsonPath;
+    parseSelection("all", SORT_NAMES, SORT_COUNT, sorts);
+    parseSelection("all", DISTRIBUTION_NAMES, DISTRIBUTION_COUNT, distributions);
+
+    for (int i = 1; i < argc; i++)
+    {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (option == "--min-size" && hasValue)
+        {
+            minSize = max(1LL, atoll(argv[++i]));
+        }
+        else if (option == "--max-size" && hasValue)
+        {
+            maxSize = atoll(argv[++i]);
+        }
+        else if (option == "--max-quadratic" && hasValue)
+        {
+            maxQuadratic = atoll(argv[++i]);
+        }
+        else if (option == "--sorts" && hasValue)
+        {
+            if (!parseSelection(argv[++i], SORT_NAMES, SORT_COUNT, sorts))
+            {
+                return 1;
+            }
+        }
+        else if (option == "--distributions" && hasValue)
+        {
+            if (!parseSelection(argv[++i], DISTRIBUTION_NAMES, DISTRIBUTION_COUNT, distributions))
+            {
+                return 1;
+            }
+        }
+        else if (option == "--no-counts")
+        {
+            counts = false;
+        }
+        else if (option == "--csv" && hasValue)
+        {
+            csvPath = argv[++i];
+        }
+        else if (option == "--json" && hasValue)
+        {
+            jsonPath = argv[++i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    int cacheFd = openHardwareCounter(CACHE_MISSES);
+    int branchFd = openHardwareCounter(BRANCH_MISSES);
+    if (cacheFd < 0 || branchFd < 0)
+    {
+        cout << "Hardware counters unavailable; cache and branch misses are reported as -1" << endl;
+    }
+
+    cout << left << setw(16) << "sort" << setw(12) << "distribution" << right << setw(11) << "n" << setw(10)
+         << "ns/elem" << setw(10) << "cmp/elem" << setw(10) << "swp/elem" << setw(10) << "mov/elem" << setw(10)
+         << "LLC/elem" << setw(10) << "br/elem" << endl;
+
+    vector<Result> results;
+    bool allSorted = true;
+    for (long long n = minSize; n <= maxSize; n *= 10)
+    {
+        for (int d : distributions)
+        {
+            vector<int> input = makeInput((Distribution)d, n, 12345);
+            for (int s : sorts)
+            {
+                if (isQuadraticCase((SortId)s, (Distribution)d) && n > maxQuadratic)
+                {
+                    continue;
+                }
+
+                Result result = {SORT_NAMES[s], DISTRIBUTION_NAMES[d], n, -1, -1, -1, -1, -1, -1};
+                if (!timeSort((SortId)s, input, cacheFd, branchFd, result))
+                {
+                    cout << SORT_NAMES[s] << " did not sort " << DISTRIBUTION_NAMES[d] << " input of " << n
+                         << " elements" << endl;
+                    allSorted = false;
+                }
+                if (counts && !isIntArraySort((SortId)s))
+                {
+                    countOperations((SortId)s, input, result);
+                }
+                results.push_back(result);
+
+                cout << left << setw(16) << result.sort << setw(12) << result.distribution << right << setw(11)
+                     << n << setw(10) << formatValue(result.nsPerElement) << setw(10)
+                     << formatValue(result.comparisons) << setw(10) << formatValue(result.swaps) << setw(10)
+                     << formatValue(result.moves) << setw(10) << formatValue(result.cacheMisses) << setw(10)
+                     << formatValue(result.branchMisses) << endl;
+            }
+        }
+    }
+
+#ifdef __linux__
+    if (cacheFd >= 0)
+    {
+        close(cacheFd);
+    }
+    if (branchFd >= 0)
+    {
+        close(branchFd);
+    }
+#endif
+
+    if (!csvPath.empty() && !writeCsv(csvPath, results))
+    {
+        cout << "Cannot write " << csvPath << endl;
+        return 1;
+    }
+    if (!jsonPath.empty() && !writeJson(jsonPath, results))
+    {
+        cout << "Cannot write " << jsonPath << endl;
+        return 1;
+    }
+    return allSorted ? 0 : 1;
+}
+
+/**
+ * Usage Instructions:
+ * 1. Compile the program with C++17 and threads (e.g., g++ -std=c++17 -O2 -pthread sort_benchmark.cpp -o sort_benchmark),
+ *    with the sort headers (generic_sort.h, quick_sort.h, ...) in the same directory
+ * 2. Run the compiled executable (e.g., ./sort_benchmark) for sizes 10 to 10^6
+ * 3. Full sweep to 10^8 with machine-readable output (needs about 1.2 GB of memory):
+ *        ./sort_benchmark --max-size 100000000 --csv results.csv --json results.json
+ * 4. A subset: ./sort_benchmark --sorts intro,tim,radix --distributions uniform,zipf
+ *
+ * Cache misses need access to perf events; on Linux you may need
+ * "sudo sysctl kernel.perf_event_paranoid=2" or lower.
+ */
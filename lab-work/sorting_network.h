@@ -0,0 +1,423 @@
+/**
+ * @file sorting_network.h
+ * @brief Vectorized sorting-network base case for small arrays of int, long long and float
+ *
+ * Sorting up to 64 elements with insertion sort costs a compare and a
+ * mispredicted branch per shifted element. This header sorts such small
+ * arrays with a bitonic sorting network held in SIMD registers, using only
+ * lane-wise min/max and permutes, so the cost is fixed and branch-free.
+ *
+ * The instruction set is picked at run time from the CPU features:
+ * AVX-512F (16 x int32/float or 8 x int64 per register), AVX2 (8 x int32/float
+ * or 4 x int64), or a scalar insertion sort when neither is available or the
+ * compiler is not GCC/Clang on x86. The program itself needs no -mavx flags;
+ * only the kernels are compiled for the wider instruction sets.
+ *
+ * Floats are ordered with min/max, so arrays containing NaN are not sorted
+ * meaningfully (the same holds for insertion sort with operator<).
+ *
+ * Requires C++17.
+ */
+
+#ifndef SORTING_NETWORK_H
+#define SORTING_NETWORK_H
+
+#include <cstddef>
+#include <limits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SORTING_NETWORK_X86 1
+#include <immintrin.h>
+#endif
+
+namespace sorting
+{
+
+const std::size_t SORTING_NETWORK_MAX = 64; ///< Largest array handled by the network
+
+/**
+ * @enum SimdLevel
+ * @brief The instruction set used by sortingNetworkSort
+ */
+enum class SimdLevel
+{
+    Scalar, ///< Insertion sort fallback
+    Avx2,   ///< 256-bit registers
+    Avx512  ///< 512-bit registers
+};
+
+/**
+ * @brief Detects the widest instruction set supported by the CPU (cached after the first call)
+ * @return The SimdLevel sortingNetworkSort uses by default
+ */
+inline SimdLevel detectSimdLevel()
+{
+#ifdef SORTING_NETWORK_X86
+    static const SimdLevel level = []()
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            return SimdLevel::Avx512;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return SimdLevel::Avx2;
+        }
+        return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+/**
+ * @brief Reports whether a vector kernel is available on this CPU
+ * @return true if sortingNetworkSort uses SIMD registers, false if it uses insertion sort
+ */
+inline bool sortingNetworkAvailable()
+{
+    return detectSimdLevel() != SimdLevel::Scalar;
+}
+
+namespace detail
+{
+
+/**
+ * @brief Builds a blend immediate/mask: element i is selected when (i & bit) != 0
+ * @param bit The lane-index bit that selects the second operand
+ * @param lanes The number of elements per register
+ * @param width The number of mask bits per element
+ */
+constexpr int laneBlendMask(int bit, int lanes, int width)
+{
+    int mask = 0;
+    for (int i = 0; i < lanes; i++)
+    {
+        if (i & bit)
+        {
+            mask |= ((1 << width) - 1) << (i * width);
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief Scalar fallback: insertion sort
+ */
+template <typename T>
+void networkFallbackSort(T *arr, std::size_t n)
+{
+    for (std::size_t i = 1; i < n; i++)
+    {
+        T key = arr[i];
+        std::size_t j = i;
+        while (j > 0 && key < arr[j - 1])
+        {
+            arr[j] = arr[j - 1];
+            j--;
+        }
+        arr[j] = key;
+    }
+}
+
+} // namespace detail
+
+#ifdef SORTING_NETWORK_X86
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#endif
+
+namespace avx2
+{
+
+/// 8 x int32 per register
+struct Int32Ops
+{
+    using Elem = int;
+    using Reg = __m256i;
+    static const int LANES = 8;
+
+    static Elem padding() { return std::numeric_limits<Elem>::max(); }
+    static Reg load(const Elem *p) { return _mm256_loadu_si256((const __m256i *)p); }
+    static void store(Elem *p, Reg v) { _mm256_storeu_si256((__m256i *)p, v); }
+    static Reg min(Reg a, Reg b) { return _mm256_min_epi32(a, b); }
+    static Reg max(Reg a, Reg b) { return _mm256_max_epi32(a, b); }
+
+    template <int XOR>
+    static Reg exchange(Reg v)
+    {
+        return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0 ^ XOR, 1 ^ XOR, 2 ^ XOR, 3 ^ XOR,
+                                                                4 ^ XOR, 5 ^ XOR, 6 ^ XOR, 7 ^ XOR));
+    }
+
+    template <int BIT>
+    static Reg blend(Reg lo, Reg hi)
+    {
+        constexpr int mask = detail::laneBlendMask(BIT, 8, 1);
+        return _mm256_blend_epi32(lo, hi, mask);
+    }
+};
+
+/// 8 x float per register
+struct FloatOps
+{
+    using Elem = float;
+    using Reg = __m256;
+    static const int LANES = 8;
+
+    static Elem padding() { return std::numeric_limits<Elem>::infinity(); }
+    static Reg load(const Elem *p) { return _mm256_loadu_ps(p); }
+    static void store(Elem *p, Reg v) { _mm256_storeu_ps(p, v); }
+    static Reg min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+    static Reg max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+
+    template <int XOR>
+    static Reg exchange(Reg v)
+    {
+        return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(0 ^ XOR, 1 ^ XOR, 2 ^ XOR, 3 ^ XOR,
+                                                             4 ^ XOR, 5 ^ XOR, 6 ^ XOR, 7 ^ XOR));
+    }
+
+    template <int BIT>
+    static Reg blend(Reg lo, Reg hi)
+    {
+        constexpr int mask = detail::laneBlendMask(BIT, 8, 1);
+        return _mm256_blend_ps(lo, hi, mask);
+    }
+};
+
+/// 4 x int64 per register; AVX2 has no 64-bit min/max, so they are built from a compare and a blend
+struct Int64Ops
+{
+    using Elem = long long;
+    using Reg = __m256i;
+    static const int LANES = 4;
+
+    static Elem padding() { return std::numeric_limits<Elem>::max(); }
+    static Reg load(const Elem *p) { return _mm256_loadu_si256((const __m256i *)p); }
+    static void store(Elem *p, Reg v) { _mm256_storeu_si256((__m256i *)p, v); }
+    static Reg min(Reg a, Reg b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+    static Reg max(Reg a, Reg b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+
+    template <int XOR>
+    static Reg exchange(Reg v)
+    {
+        return _mm256_permute4x64_epi64(v, (0 ^ XOR) | ((1 ^ XOR) << 2) | ((2 ^ XOR) << 4) | ((3 ^ XOR) << 6));
+    }
+
+    template <int BIT>
+    static Reg blend(Reg lo, Reg hi)
+    {
+        constexpr int mask = detail::laneBlendMask(BIT, 4, 2);
+        return _mm256_blend_epi32(lo, hi, mask);
+    }
+};
+
+#include "sorting_network_kernel.h"
+
+} // namespace avx2
+
+#ifdef __clang__
+#pragma clang attribute pop
+#endif
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+// GCC 12 reports false -Wmaybe-uninitialized warnings inside its own AVX-512 intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#endif
+
+namespace avx512
+{
+
+/// 16 x int32 per register
+struct Int32Ops
+{
+    using Elem = int;
+    using Reg = __m512i;
+    static const int LANES = 16;
+
+    static Elem padding() { return std::numeric_limits<Elem>::max(); }
+    static Reg load(const Elem *p) { return _mm512_loadu_si512(p); }
+    static void store(Elem *p, Reg v) { _mm512_storeu_si512(p, v); }
+    static Reg min(Reg a, Reg b) { return _mm512_min_epi32(a, b); }
+    static Reg max(Reg a, Reg b) { return _mm512_max_epi32(a, b); }
+
+    template <int XOR>
+    static Reg exchange(Reg v)
+    {
+        return _mm512_permutexvar_epi32(_mm512_setr_epi32(0 ^ XOR, 1 ^ XOR, 2 ^ XOR, 3 ^ XOR, 4 ^ XOR, 5 ^ XOR,
+                                                          6 ^ XOR, 7 ^ XOR, 8 ^ XOR, 9 ^ XOR, 10 ^ XOR, 11 ^ XOR,
+                                                          12 ^ XOR, 13 ^ XOR, 14 ^ XOR, 15 ^ XOR),
+                                        v);
+    }
+
+    template <int BIT>
+    static Reg blend(Reg lo, Reg hi)
+    {
+        constexpr int mask = detail::laneBlendMask(BIT, 16, 1);
+        return _mm512_mask_blend_epi32((__mmask16)mask, lo, hi);
+    }
+};
+
+/// 16 x float per register
+struct FloatOps
+{
+    using Elem = float;
+    using Reg = __m512;
+    static const int LANES = 16;
+
+    static Elem padding() { return std::numeric_limits<Elem>::infinity(); }
+    static Reg load(const Elem *p) { return _mm512_loadu_ps(p); }
+    static void store(Elem *p, Reg v) { _mm512_storeu_ps(p, v); }
+    static Reg min(Reg a, Reg b) { return _mm512_min_ps(a, b); }
+    static Reg max(Reg a, Reg b) { return _mm512_max_ps(a, b); }
+
+    template <int XOR>
+    static Reg exchange(Reg v)
+    {
+        return _mm512_permutexvar_ps(_mm512_setr_epi32(0 ^ XOR, 1 ^ XOR, 2 ^ XOR, 3 ^ XOR, 4 ^ XOR, 5 ^ XOR,
+                                                       6 ^ XOR, 7 ^ XOR, 8 ^ XOR, 9 ^ XOR, 10 ^ XOR, 11 ^ XOR,
+                                                       12 ^ XOR, 13 ^ XOR, 14 ^ XOR, 15 ^ XOR),
+                                     v);
+    }
+
+    template <int BIT>
+    static Reg blend(Reg lo, Reg hi)
+    {
+        constexpr int mask = detail::laneBlendMask(BIT, 16, 1);
+        return _mm512_mask_blend_ps((__mmask16)mask, lo, hi);
+    }
+};
+
+/// 8 x int64 per register
+struct Int64Ops
+{
+    using Elem = long long;
+    using Reg = __m512i;
+    static const int LANES = 8;
+
+    static Elem padding() { return std::numeric_limits<Elem>::max(); }
+    static Reg load(const Elem *p) { return _mm512_loadu_si512(p); }
+    static void store(Elem *p, Reg v) { _mm512_storeu_si512(p, v); }
+    static Reg min(Reg a, Reg b) { return _mm512_min_epi64(a, b); }
+    static Reg max(Reg a, Reg b) { return _mm512_max_epi64(a, b); }
+
+    template <int XOR>
+    static Reg exchange(Reg v)
+    {
+        return _mm512_permutexvar_epi64(_mm512_setr_epi64(0 ^ XOR, 1 ^ XOR, 2 ^ XOR, 3 ^ XOR,
+                                                          4 ^ XOR, 5 ^ XOR, 6 ^ XOR, 7 ^ XOR),
+                                        v);
+    }
+
+    template <int BIT>
+    static Reg blend(Reg lo, Reg hi)
+    {
+        constexpr int mask = detail::laneBlendMask(BIT, 8, 1);
+        return _mm512_mask_blend_epi64((__mmask8)mask, lo, hi);
+    }
+};
+
+#include "sorting_network_kernel.h"
+
+} // namespace avx512
+
+#ifdef __clang__
+#pragma clang attribute pop
+#endif
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+
+#endif // SORTING_NETWORK_X86
+
+namespace detail
+{
+
+/**
+ * @brief Dispatches to the kernel for the requested instruction set
+ */
+template <typename T, typename Avx2Ops, typename Avx512Ops>
+void dispatchNetworkSort(T *arr, std::size_t n, SimdLevel level)
+{
+    if (n < 2)
+    {
+        return;
+    }
+    if (n > SORTING_NETWORK_MAX)
+    {
+        networkFallbackSort(arr, n);
+        return;
+    }
+#ifdef SORTING_NETWORK_X86
+    if (level == SimdLevel::Avx512)
+    {
+        avx512::networkSort<Avx512Ops>(arr, n);
+        return;
+    }
+    if (level == SimdLevel::Avx2)
+    {
+        avx2::networkSort<Avx2Ops>(arr, n);
+        return;
+    }
+#else
+    (void)level;
+#endif
+    networkFallbackSort(arr, n);
+}
+
+} // namespace detail
+
+#ifdef SORTING_NETWORK_X86
+#define SORTING_NETWORK_OPS(type) avx2::type, avx512::type
+#else
+#define SORTING_NETWORK_OPS(type) void, void
+#endif
+
+/**
+ * @brief Sorts a small array of int in ascending order
+ * @param arr The array to be sorted
+ * @param n The number of elements; arrays above SORTING_NETWORK_MAX use insertion sort
+ * @param level The instruction set to use; must be supported by the CPU
+ */
+inline void sortingNetworkSort(int *arr, std::size_t n, SimdLevel level = detectSimdLevel())
+{
+    detail::dispatchNetworkSort<int, SORTING_NETWORK_OPS(Int32Ops)>(arr, n, level);
+}
+
+/**
+ * @brief Sorts a small array of long long in ascending order
+ * @param arr The array to be sorted
+ * @param n The number of elements; arrays above SORTING_NETWORK_MAX use insertion sort
+ * @param level The instruction set to use; must be supported by the CPU
+ */
+inline void sortingNetworkSort(long long *arr, std::size_t n, SimdLevel level = detectSimdLevel())
+{
+    detail::dispatchNetworkSort<long long, SORTING_NETWORK_OPS(Int64Ops)>(arr, n, level);
+}
+
+/**
+ * @brief Sorts a small array of float in ascending order
+ * @param arr The array to be sorted
+ * @param n The number of elements; arrays above SORTING_NETWORK_MAX use insertion sort
+ * @param level The instruction set to use; must be supported by the CPU
+ */
+inline void sortingNetworkSort(float *arr, std::size_t n, SimdLevel level = detectSimdLevel())
+{
+    detail::dispatchNetworkSort<float, SORTING_NETWORK_OPS(FloatOps)>(arr, n, level);
+}
+
+#undef SORTING_NETWORK_OPS
+
+} // namespace sorting
+
+#endif // SORTING_NETWORK_H
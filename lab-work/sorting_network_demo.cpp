@@ -0,0 +1,164 @@
+/**
+ * @file sorting_network_demo.cpp
+ * @brief Demonstration and check of the vectorized sorting networks in sorting_network.h
+ *
+ * This program reports the instruction set picked at run time, checks every
+ * available kernel against std::sort for all sizes up to SORTING_NETWORK_MAX,
+ * and times the network against insertion sort on many small arrays.
+ */
+
+#include "sorting_network.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Returns a printable name for an instruction set
+ * @param level The instruction set
+ * @return Its name
+ */
+const char *simdLevelName(sorting::SimdLevel level)
+{
+    switch (level)
+    {
+    case sorting::SimdLevel::Avx512:
+        return "AVX-512";
+    case sorting::SimdLevel::Avx2:
+        return "AVX2";
+    default:
+        return "scalar";
+    }
+}
+
+/**
+ * @brief Checks one kernel against std::sort for every size from 0 to SORTING_NETWORK_MAX
+ * @param level The instruction set to check
+ * @param generator The random source
+ * @return true if every array was sorted correctly
+ */
+template <typename T>
+bool checkKernel(sorting::SimdLevel level, mt19937 &generator)
+{
+    for (size_t n = 0; n <= sorting::SORTING_NETWORK_MAX; n++)
+    {
+        for (int trial = 0; trial < 50; trial++)
+        {
+            vector<T> arr(n);
+            for (T &x : arr)
+            {
+                // Small range so duplicates are common, and negative values
+                x = (T)((int)(generator() % 200) - 100);
+            }
+            vector<T> expected(arr);
+            sort(expected.begin(), expected.end());
+
+            sorting::sortingNetworkSort(arr.data(), n, level);
+            if (arr != expected)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Performs insertion sort on an array, as in insertion_sort.cpp
+ * @param arr The array to be sorted
+ * @param n The number of elements in the array
+ */
+void insertionSort(int arr[], int n)
+{
+    for (int i = 1; i < n; i++)
+    {
+        int key = arr[i];
+        int j = i - 1;
+        while (j >= 0 && arr[j] > key)
+        {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+/**
+ * @brief Main function to check and time the sorting networks
+ * @return 0 if every kernel sorted correctly, 1 otherwise
+ */
+int main()
+{
+    sorting::SimdLevel detected = sorting::detectSimdLevel();
+    cout << "Detected instruction set: " << simdLevelName(detected) << endl;
+
+    // Check the detected level and every narrower one
+    vector<sorting::SimdLevel> levels = {sorting::SimdLevel::Scalar};
+    if (detected != sorting::SimdLevel::Scalar)
+    {
+        levels.push_back(sorting::SimdLevel::Avx2);
+    }
+    if (detected == sorting::SimdLevel::Avx512)
+    {
+        levels.push_back(sorting::SimdLevel::Avx512);
+    }
+
+    mt19937 generator(42);
+    bool allCorrect = true;
+    for (sorting::SimdLevel level : levels)
+    {
+        bool ok = checkKernel<int>(level, generator) && checkKernel<long long>(level, generator) &&
+                  checkKernel<float>(level, generator);
+        allCorrect = allCorrect && ok;
+        cout << simdLevelName(level) << " kernels (int, long long, float): " << (ok ? "correct" : "WRONG") << endl;
+    }
+
+    // Time many random 64-element sorts with each method
+    const int arrays = 200000;
+    const int size = (int)sorting::SORTING_NETWORK_MAX;
+    vector<int> input((size_t)arrays * size);
+    for (int &x : input)
+    {
+        x = (int)generator();
+    }
+
+    cout << endl << "Sorting " << arrays << " random arrays of " << size << " ints" << endl;
+    vector<int> arr(input);
+    auto start = chrono::steady_clock::now();
+    for (int a = 0; a < arrays; a++)
+    {
+        insertionSort(arr.data() + (size_t)a * size, size);
+    }
+    auto end = chrono::steady_clock::now();
+    cout << "insertionSort: " << chrono::duration<double, nano>(end - start).count() / arrays << " ns/array" << endl;
+
+    for (sorting::SimdLevel level : levels)
+    {
+        arr = input;
+        start = chrono::steady_clock::now();
+        for (int a = 0; a < arrays; a++)
+        {
+            sorting::sortingNetworkSort(arr.data() + (size_t)a * size, size, level);
+        }
+        end = chrono::steady_clock::now();
+        cout << simdLevelName(level) << " sortingNetworkSort: "
+             << chrono::duration<double, nano>(end - start).count() / arrays << " ns/array" << endl;
+    }
+
+    return allCorrect ? 0 : 1;
+}
+
+/**
+ * Usage Instructions:
+ * 1. Compile the program with C++17 (e.g., g++ -std=c++17 -O2 sorting_network_demo.cpp -o sorting_network_demo)
+ *    No -mavx2 or -mavx512f flag is needed; the kernels are selected at run time.
+ * 2. Run the compiled executable (e.g., ./sorting_network_demo)
+ *
+ * To use the sorting networks in your own code:
+ * 1. #include "sorting_network.h" (sorting_network_kernel.h must be next to it)
+ * 2. Call sorting::sortingNetworkSort(your_array, array_size) for int, long long or float
+ *    arrays of up to sorting::SORTING_NETWORK_MAX elements
+ */
@@ -0,0 +1,180 @@
+/**
+ * @file sorting_network_kernel.h
+ * @brief Bitonic sorting network over SIMD registers, written once for every instruction set
+ *
+ * This file is included by sorting_network.h once per instruction set,
+ * inside a namespace that defines the vector traits (Int32Ops, Int64Ops,
+ * FloatOps) and inside a "#pragma GCC target" region for that instruction
+ * set, so the compiler may use its intrinsics here. It deliberately has no
+ * include guard. Do not include it directly.
+ *
+ * A traits type V provides:
+ * - Elem, Reg and LANES: the element type, the register type and its lane count
+ * - load, store, min, max: unaligned load/store and lane-wise min/max
+ * - exchange<XOR>(v): lane i receives lane i ^ XOR of v
+ * - blend<BIT>(lo, hi): lane i is taken from hi if (i & BIT) != 0, else from lo
+ */
+
+/**
+ * @brief One comparator stage: lane i is compared with lane i ^ XOR
+ *
+ * Lanes with bit BIT set keep the larger value, the others the smaller one.
+ */
+template <typename V, int XOR, int BIT>
+inline typename V::Reg networkStage(typename V::Reg v)
+{
+    typename V::Reg partner = V::template exchange<XOR>(v);
+    return V::template blend<BIT>(V::min(v, partner), V::max(v, partner));
+}
+
+/**
+ * @brief Sorts the lanes of one register in ascending order
+ *
+ * Merges sorted runs of 1, 2, 4 ... lanes. Each merge starts with a "flip"
+ * stage (lane i against its mirror i ^ (2s - 1) within the 2s-lane block)
+ * followed by half-cleaner stages at distances s/2 ... 1.
+ */
+template <typename V>
+inline typename V::Reg sortRegister(typename V::Reg v)
+{
+    v = networkStage<V, 1, 1>(v);
+
+    v = networkStage<V, 3, 2>(v);
+    v = networkStage<V, 1, 1>(v);
+
+    if constexpr (V::LANES >= 8)
+    {
+        v = networkStage<V, 7, 4>(v);
+        v = networkStage<V, 2, 2>(v);
+        v = networkStage<V, 1, 1>(v);
+    }
+    if constexpr (V::LANES >= 16)
+    {
+        v = networkStage<V, 15, 8>(v);
+        v = networkStage<V, 4, 4>(v);
+        v = networkStage<V, 2, 2>(v);
+        v = networkStage<V, 1, 1>(v);
+    }
+    return v;
+}
+
+/**
+ * @brief Sorts a bitonic register with half-cleaner stages
+ */
+template <typename V>
+inline typename V::Reg cleanRegister(typename V::Reg v)
+{
+    if constexpr (V::LANES >= 16)
+    {
+        v = networkStage<V, 8, 8>(v);
+    }
+    if constexpr (V::LANES >= 8)
+    {
+        v = networkStage<V, 4, 4>(v);
+    }
+    v = networkStage<V, 2, 2>(v);
+    v = networkStage<V, 1, 1>(v);
+    return v;
+}
+
+/**
+ * @brief Sorts numRegisters * LANES elements held in registers
+ * @param v The registers, sorted as one sequence in register order
+ * @param numRegisters The number of registers, a power of two
+ *
+ * Each register is sorted on its own, then runs of w registers are merged
+ * pairwise for w = 1, 2, 4 ... The merge compares each register of the left
+ * run with the lane-reversed mirror register of the right run, then cleans
+ * both runs across registers and finally within each register.
+ */
+template <typename V>
+inline void sortRegisters(typename V::Reg *v, int numRegisters)
+{
+    for (int r = 0; r < numRegisters; r++)
+    {
+        v[r] = sortRegister<V>(v[r]);
+    }
+
+    for (int w = 1; w < numRegisters; w *= 2)
+    {
+        for (int base = 0; base < numRegisters; base += 2 * w)
+        {
+            // Flip: left run against the reversed right run
+            for (int r = 0; r < w; r++)
+            {
+                typename V::Reg &left = v[base + r];
+                typename V::Reg &right = v[base + 2 * w - 1 - r];
+                typename V::Reg mirrored = V::template exchange<V::LANES - 1>(right);
+                typename V::Reg high = V::max(left, mirrored);
+                left = V::min(left, mirrored);
+                right = V::template exchange<V::LANES - 1>(high);
+            }
+
+            // Half-cleaners across registers within each run
+            for (int d = w / 2; d >= 1; d /= 2)
+            {
+                for (int r = base; r < base + 2 * w; r++)
+                {
+                    if (((r - base) & d) == 0)
+                    {
+                        typename V::Reg low = V::min(v[r], v[r + d]);
+                        v[r + d] = V::max(v[r], v[r + d]);
+                        v[r] = low;
+                    }
+                }
+            }
+
+            for (int r = base; r < base + 2 * w; r++)
+            {
+                v[r] = cleanRegister<V>(v[r]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sorts up to SORTING_NETWORK_MAX elements with the vector network
+ * @param arr The array to be sorted
+ * @param n The number of elements, at most SORTING_NETWORK_MAX
+ *
+ * The input is copied into a buffer padded with the largest element value,
+ * so the padding sorts to the end and is dropped when copying back.
+ */
+template <typename V>
+void networkSort(typename V::Elem *arr, std::size_t n)
+{
+    const int maxRegisters = SORTING_NETWORK_MAX / V::LANES;
+    alignas(64) typename V::Elem buffer[SORTING_NETWORK_MAX];
+    typename V::Reg v[maxRegisters];
+
+    int numRegisters = 1;
+    while ((std::size_t)(numRegisters * V::LANES) < n)
+    {
+        numRegisters *= 2;
+    }
+
+    std::size_t padded = (std::size_t)(numRegisters * V::LANES);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        buffer[i] = arr[i];
+    }
+    for (std::size_t i = n; i < padded; i++)
+    {
+        buffer[i] = V::padding();
+    }
+
+    for (int r = 0; r < numRegisters; r++)
+    {
+        v[r] = V::load(buffer + r * V::LANES);
+    }
+    sortRegisters<V>(v, numRegisters);
+    for (int r = 0; r < numRegisters; r++)
+    {
+        V::store(buffer + r * V::LANES, v[r]);
+    }
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        arr[i] = buffer[i];
+    }
+}
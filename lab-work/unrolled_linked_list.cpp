@@ -0,0 +1,711 @@
+/**
+ * @file unrolled_linked_list.cpp
+ * @brief Implementation of an unrolled linked list of integers
+ *
+ * The lists in linked_list_insertion.cpp and the doubly linked list files
+ * keep one int per node, so every 4-byte value carries 8 to 16 bytes of
+ * pointers, and a traversal takes a cache miss per value. An unrolled
+ * linked list keeps up to NODE_CAPACITY values in an array inside each
+ * node, and each node fills two cache lines:
+ *
+ * - Inserting into a full node splits it into two half-full nodes.
+ * - Deleting from a node that falls below half full borrows values from the
+ *   next node, or merges with it if both fit in one node.
+ * - So every node but the last is at least half full, and a list of n
+ *   values takes at most about 2n / NODE_CAPACITY nodes.
+ *
+ * Nodes come from a NodePool (node_pool.h). Running the program with
+ * --benchmark compares memory and traversal time with a one-int-per-node list.
+ */
+
+#include "node_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+const int NODE_BYTES = 128; ///< Size of a node: two 64-byte cache lines
+
+/// Values per node: what is left of NODE_BYTES after the next pointer and the count
+const int NODE_CAPACITY = (int)((NODE_BYTES - sizeof(void *) - sizeof(int)) / sizeof(int));
+
+const int MIN_FILL = NODE_CAPACITY / 2; ///< Every node but the last holds at least this many values
+
+/**
+ * @struct UnrolledNode
+ * @brief Represents a node of the unrolled linked list
+ *
+ * Holds count values in values[0..count), in list order.
+ */
+struct alignas(64) UnrolledNode
+{
+    UnrolledNode *next;          ///< Pointer to the next node in the list
+    int count;                   ///< Number of values in use
+    int values[NODE_CAPACITY];   ///< The values stored in the node
+};
+
+static_assert(sizeof(UnrolledNode) == NODE_BYTES, "UnrolledNode should fill exactly two cache lines");
+
+/**
+ * @class UnrolledLinkedList
+ * @brief Implements a singly linked list that stores an array of values per node
+ *
+ * This class provides the insertion and deletion operations of the linked
+ * list files. The operations that print a message have quiet counterparts
+ * (prepend, append, addAfter, addBefore, remove) for use in loops.
+ */
+class UnrolledLinkedList
+{
+private:
+    UnrolledNode *head;             ///< Pointer to the first node in the list
+    UnrolledNode *tail;             ///< Pointer to the last node in the list
+    int size;                       ///< Number of values in the list
+    NodePool<UnrolledNode> nodes;   ///< Allocates and frees the nodes of this list
+
+    /**
+     * @brief Creates an empty node
+     * @param next The node to link after the new one
+     * @return Pointer to the newly created node
+     */
+    UnrolledNode *createNode(UnrolledNode *next)
+    {
+        UnrolledNode *node = nodes.create();
+        node->next = next;
+        return node;
+    }
+
+    /**
+     * @brief Finds the first occurrence of a value
+     * @param value The value to search for
+     * @param prev Set to the node before the one holding value, or nullptr
+     * @param node Set to the node holding value
+     * @param index Set to the position of value within node
+     * @return true if the value is found, false otherwise
+     */
+    bool find(int value, UnrolledNode *&prev, UnrolledNode *&node, int &index) const
+    {
+        prev = nullptr;
+        for (node = head; node != nullptr; prev = node, node = node->next)
+        {
+            for (index = 0; index < node->count; index++)
+            {
+                if (node->values[index] == value)
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Inserts a value at a position within a node, splitting the node if it is full
+     * @param node The node
+     * @param index The position, from 0 to node->count
+     * @param value The value to be inserted
+     *
+     * A full node moves its upper half to a new node linked after it, and
+     * the value goes into whichever half holds its position.
+     */
+    void insertAt(UnrolledNode *node, int index, int value)
+    {
+        if (node->count == NODE_CAPACITY)
+        {
+            UnrolledNode *upper = createNode(node->next);
+            upper->count = NODE_CAPACITY - MIN_FILL;
+            copy(node->values + MIN_FILL, node->values + NODE_CAPACITY, upper->values);
+            node->count = MIN_FILL;
+            node->next = upper;
+            if (tail == node)
+            {
+                tail = upper;
+            }
+            if (index > MIN_FILL)
+            {
+                node = upper;
+                index -= MIN_FILL;
+            }
+        }
+
+        copy_backward(node->values + index, node->values + node->count, node->values + node->count + 1);
+        node->values[index] = value;
+        node->count++;
+        size++;
+    }
+
+    /**
+     * @brief Removes the value at a position within a node, refilling the node if needed
+     * @param prev The node before node, or nullptr if node is the head
+     * @param node The node
+     * @param index The position of the value within node
+     *
+     * A node left below MIN_FILL merges with the next node if both fit in
+     * one node, and otherwise borrows values from it up to MIN_FILL. The
+     * last node has no next node; it is only unlinked once it is empty.
+     */
+    void removeAt(UnrolledNode *prev, UnrolledNode *node, int index)
+    {
+        copy(node->values + index + 1, node->values + node->count, node->values + index);
+        node->count--;
+        size--;
+        if (node->count >= MIN_FILL)
+        {
+            return;
+        }
+
+        UnrolledNode *next = node->next;
+        if (next != nullptr)
+        {
+            if (node->count + next->count <= NODE_CAPACITY)
+            {
+                // Merge: take every value of next and free it
+                copy(next->values, next->values + next->count, node->values + node->count);
+                node->count += next->count;
+                node->next = next->next;
+                if (tail == next)
+                {
+                    tail = node;
+                }
+                nodes.destroy(next);
+            }
+            else
+            {
+                // Borrow: next keeps more than MIN_FILL values
+                int borrowed = MIN_FILL - node->count;
+                copy(next->values, next->values + borrowed, node->values + node->count);
+                copy(next->values + borrowed, next->values + next->count, next->values);
+                node->count += borrowed;
+                next->count -= borrowed;
+            }
+        }
+        else if (node->count == 0)
+        {
+            // The last node is empty: unlink it
+            if (prev == nullptr)
+            {
+                head = nullptr;
+            }
+            else
+            {
+                prev->next = nullptr;
+            }
+            tail = prev;
+            nodes.destroy(node);
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor for the UnrolledLinkedList class
+     *
+     * Initializes an empty list with null head and tail pointers.
+     */
+    UnrolledLinkedList()
+    {
+        head = nullptr;
+        tail = nullptr;
+        size = 0;
+    }
+
+    /**
+     * @brief Destructor for the UnrolledLinkedList class
+     *
+     * The NodePool frees every node at once, without walking the list.
+     */
+    ~UnrolledLinkedList()
+    {
+        nodes.releaseAll();
+    }
+
+    UnrolledLinkedList(const UnrolledLinkedList &) = delete;
+    UnrolledLinkedList &operator=(const UnrolledLinkedList &) = delete;
+
+    /**
+     * @brief Inserts a value at the beginning of the list without printing
+     * @param value The integer value to be inserted
+     */
+    void prepend(int value)
+    {
+        if (head == nullptr)
+        {
+            head = tail = createNode(nullptr);
+        }
+        insertAt(head, 0, value);
+    }
+
+    /**
+     * @brief Inserts a value at the end of the list without printing
+     * @param value The integer value to be inserted
+     *
+     * A full tail is not split: a new tail is started, so a list built by
+     * appending has every node but the last full.
+     */
+    void append(int value)
+    {
+        if (tail == nullptr)
+        {
+            head = tail = createNode(nullptr);
+        }
+        else if (tail->count == NODE_CAPACITY)
+        {
+            tail->next = createNode(nullptr);
+            tail = tail->next;
+        }
+        tail->values[tail->count++] = value;
+        size++;
+    }
+
+    /**
+     * @brief Inserts a value after the first occurrence of another without printing
+     * @param specificValue The value to search for in the list
+     * @param newValue The value to be inserted
+     * @return true if specificValue was found and newValue inserted, false otherwise
+     */
+    bool addAfter(int specificValue, int newValue)
+    {
+        UnrolledNode *prev, *node;
+        int index;
+        if (!find(specificValue, prev, node, index))
+        {
+            return false;
+        }
+        insertAt(node, index + 1, newValue);
+        return true;
+    }
+
+    /**
+     * @brief Inserts a value before the first occurrence of another without printing
+     * @param specificValue The value to search for in the list
+     * @param newValue The value to be inserted
+     * @return true if specificValue was found and newValue inserted, false otherwise
+     */
+    bool addBefore(int specificValue, int newValue)
+    {
+        UnrolledNode *prev, *node;
+        int index;
+        if (!find(specificValue, prev, node, index))
+        {
+            return false;
+        }
+        insertAt(node, index, newValue);
+        return true;
+    }
+
+    /**
+     * @brief Deletes the first occurrence of a value without printing
+     * @param value The value to be deleted
+     * @return true if the value was found and deleted, false otherwise
+     */
+    bool remove(int value)
+    {
+        UnrolledNode *prev, *node;
+        int index;
+        if (!find(value, prev, node, index))
+        {
+            return false;
+        }
+        removeAt(prev, node, index);
+        return true;
+    }
+
+    /**
+     * @brief Inserts a value at the beginning of the list
+     * @param value The integer value to be inserted
+     */
+    void insertFirst(int value)
+    {
+        prepend(value);
+        cout << "Inserted " << value << " at the beginning." << endl;
+    }
+
+    /**
+     * @brief Inserts a value at the end of the list
+     * @param value The integer value to be inserted
+     */
+    void insertLast(int value)
+    {
+        append(value);
+        cout << "Inserted " << value << " at the end." << endl;
+    }
+
+    /**
+     * @brief Inserts a value after the first occurrence of a specific value
+     * @param specificValue The value to search for in the list
+     * @param newValue The value to be inserted
+     */
+    void insertAfter(int specificValue, int newValue)
+    {
+        if (addAfter(specificValue, newValue))
+        {
+            cout << "Inserted " << newValue << " after " << specificValue << "." << endl;
+        }
+        else
+        {
+            cout << "Node with value " << specificValue << " not found." << endl;
+        }
+    }
+
+    /**
+     * @brief Inserts a value before the first occurrence of a specific value
+     * @param specificValue The value to search for in the list
+     * @param newValue The value to be inserted
+     */
+    void insertBefore(int specificValue, int newValue)
+    {
+        if (addBefore(specificValue, newValue))
+        {
+            cout << "Inserted " << newValue << " before " << specificValue << "." << endl;
+        }
+        else
+        {
+            cout << "Node with value " << specificValue << " not found." << endl;
+        }
+    }
+
+    /**
+     * @brief Deletes the first occurrence of a specific value
+     * @param value The value to be deleted
+     */
+    void deleteSpecific(int value)
+    {
+        if (remove(value))
+        {
+            cout << "Deleted node with value " << value << "." << endl;
+        }
+        else
+        {
+            cout << "Node with value " << value << " not found." << endl;
+        }
+    }
+
+    /**
+     * @brief Searches for a value in the list
+     * @param value The value to search for
+     * @return true if the value is found, false otherwise
+     */
+    bool search(int value) const
+    {
+        UnrolledNode *prev, *node;
+        int index;
+        return find(value, prev, node, index);
+    }
+
+    /**
+     * @brief Returns the number of values in the list, in O(1)
+     */
+    int countNodes() const
+    {
+        return size;
+    }
+
+    /**
+     * @brief Returns the bytes taken by the nodes of the list
+     */
+    size_t memoryBytes() const
+    {
+        return nodes.size() * sizeof(UnrolledNode);
+    }
+
+    /**
+     * @brief Calls visit(value) for every value, in list order
+     */
+    template <typename Visit>
+    void forEach(Visit visit) const
+    {
+        for (const UnrolledNode *node = head; node != nullptr; node = node->next)
+        {
+            for (int i = 0; i < node->count; i++)
+            {
+                visit(node->values[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Checks the size, the tail pointer and the fill of every node
+     * @return true if every node but the last holds at least MIN_FILL values
+     */
+    bool isWellFormed() const
+    {
+        int values = 0;
+        const UnrolledNode *last = nullptr;
+        for (const UnrolledNode *node = head; node != nullptr; node = node->next)
+        {
+            if (node->count < 1 || node->count > NODE_CAPACITY || (node->next != nullptr && node->count < MIN_FILL))
+            {
+                return false;
+            }
+            values += node->count;
+            last = node;
+        }
+        return values == size && last == tail;
+    }
+
+    /**
+     * @brief Displays the contents of the list, one bracketed group per node
+     */
+    void display() const
+    {
+        if (head == nullptr)
+        {
+            cout << "List is empty." << endl;
+            return;
+        }
+        cout << "Unrolled Linked List: ";
+        for (const UnrolledNode *node = head; node != nullptr; node = node->next)
+        {
+            cout << "[";
+            for (int i = 0; i < node->count; i++)
+            {
+                cout << (i > 0 ? " " : "") << node->values[i];
+            }
+            cout << "] -> ";
+        }
+        cout << "nullptr" << endl;
+    }
+};
+
+/**
+ * @struct Node
+ * @brief A node of the one-int-per-node list the benchmark compares against
+ */
+struct Node
+{
+    int data;   ///< The data stored in the node
+    Node *next; ///< Pointer to the next node in the list
+};
+
+/**
+ * @brief Applies random insertions and deletions to the list and to a vector
+ * @param operations The number of random operations
+ * @return true if the list always matched the vector and stayed well formed
+ */
+bool checkAgainstVector(int operations)
+{
+    mt19937 generator(24);
+    UnrolledLinkedList list;
+    vector<int> expected;
+    for (int i = 0; i < operations; i++)
+    {
+        int value = (int)(generator() % 2000);
+        int other = (int)(generator() % 2000);
+        auto found = find(expected.begin(), expected.end(), other);
+        switch (generator() % 6)
+        {
+        case 0:
+            list.prepend(value);
+            expected.insert(expected.begin(), value);
+            break;
+        case 1:
+            list.append(value);
+            expected.push_back(value);
+            break;
+        case 2:
+            if (list.addAfter(other, value) != (found != expected.end()))
+            {
+                return false;
+            }
+            if (found != expected.end())
+            {
+                expected.insert(found + 1, value);
+            }
+            break;
+        case 3:
+            if (list.addBefore(other, value) != (found != expected.end()))
+            {
+                return false;
+            }
+            if (found != expected.end())
+            {
+                expected.insert(found, value);
+            }
+            break;
+        default:
+            if (list.remove(other) != (found != expected.end()))
+            {
+                return false;
+            }
+            if (found != expected.end())
+            {
+                expected.erase(found);
+            }
+        }
+        if (!list.isWellFormed() || list.countNodes() != (int)expected.size())
+        {
+            return false;
+        }
+    }
+
+    vector<int> actual;
+    list.forEach([&](int value) { actual.push_back(value); });
+    return actual == expected;
+}
+
+/**
+ * @brief Compares memory and traversal time with a one-int-per-node list
+ * @param n The number of values in each list
+ * @return 0 if both lists hold the same values and the random check passes, 1 otherwise
+ */
+int runBenchmark(int n)
+{
+    const int rounds = 20;
+    NodePool<Node> plainNodes;
+    Node *plainHead = nullptr;
+    Node *plainTail = nullptr;
+    UnrolledLinkedList list;
+    for (int i = 0; i < n; i++)
+    {
+        Node *node = plainNodes.create(i, nullptr);
+        (plainTail == nullptr ? plainHead : plainTail->next) = node;
+        plainTail = node;
+        list.append(i);
+    }
+
+    // Search for a missing value, which visits every value
+    auto start = chrono::steady_clock::now();
+    int plainFound = 0;
+    for (int r = 0; r < rounds; r++)
+    {
+        Node *temp = plainHead;
+        while (temp != nullptr && temp->data != -1 - r)
+        {
+            temp = temp->next;
+        }
+        plainFound += temp != nullptr;
+    }
+    auto end = chrono::steady_clock::now();
+    double plainNs = chrono::duration<double, nano>(end - start).count() / ((double)rounds * n);
+
+    start = chrono::steady_clock::now();
+    int unrolledFound = 0;
+    for (int r = 0; r < rounds; r++)
+    {
+        unrolledFound += list.search(-1 - r);
+    }
+    end = chrono::steady_clock::now();
+    double unrolledNs = chrono::duration<double, nano>(end - start).count() / ((double)rounds * n);
+
+    cout << "Values: " << n << ", " << NODE_CAPACITY << " per unrolled node" << endl;
+    cout << "list\t\tbytes/value\tns/value searched" << endl;
+    cout << "one per node\t" << (double)plainNodes.size() * sizeof(Node) / n << "\t\t" << plainNs << endl;
+    cout << "unrolled\t" << (double)list.memoryBytes() / n << "\t\t" << unrolledNs << endl;
+
+    // Shuffle the order of the plain list's nodes in memory, as a list built by
+    // inserting in the middle ends up, and time it again
+    vector<Node *> order;
+    for (Node *temp = plainHead; temp != nullptr; temp = temp->next)
+    {
+        order.push_back(temp);
+    }
+    shuffle(order.begin(), order.end(), mt19937(7));
+    for (size_t i = 0; i + 1 < order.size(); i++)
+    {
+        order[i]->next = order[i + 1];
+    }
+    if (!order.empty())
+    {
+        order.back()->next = nullptr;
+        plainHead = order.front();
+    }
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        Node *temp = plainHead;
+        while (temp != nullptr && temp->data != -1 - r)
+        {
+            temp = temp->next;
+        }
+        plainFound += temp != nullptr;
+    }
+    end = chrono::steady_clock::now();
+    cout << "shuffled nodes\t" << (double)plainNodes.size() * sizeof(Node) / n << "\t\t"
+         << chrono::duration<double, nano>(end - start).count() / ((double)rounds * n) << endl;
+
+    bool checked = checkAgainstVector(200000);
+    cout << "Random insert/delete check against vector: " << (checked ? "passed" : "FAILED") << endl;
+    return plainFound == 0 && unrolledFound == 0 && list.isWellFormed() && checked ? 0 : 1;
+}
+
+/**
+ * @brief Main function implementing a menu-driven interface for the UnrolledLinkedList
+ * @param argc Number of command-line arguments
+ * @param argv Pass --benchmark [n] to compare with a one-int-per-node list instead
+ * @return 0 on successful execution
+ */
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && string(argv[1]) == "--benchmark")
+    {
+        return runBenchmark(argc > 2 ? atoi(argv[2]) : 1000000);
+    }
+
+    UnrolledLinkedList list;
+    int choice, value, specificValue;
+
+    do
+    {
+        cout << "\nMenu:\n1. Insert at beginning\n2. Insert at end\n3. Insert after a value\n4. Insert before a value"
+                "\n5. Delete a value\n6. Search\n7. Display\n8. Exit\nEnter choice: ";
+        cin >> choice;
+
+        switch (choice)
+        {
+        case 1:
+            cout << "Enter value to insert at beginning: ";
+            cin >> value;
+            list.insertFirst(value);
+            break;
+        case 2:
+            cout << "Enter value to insert at end: ";
+            cin >> value;
+            list.insertLast(value);
+            break;
+        case 3:
+            cout << "Enter the value to insert after, then the value to insert: ";
+            cin >> specificValue >> value;
+            list.insertAfter(specificValue, value);
+            break;
+        case 4:
+            cout << "Enter the value to insert before, then the value to insert: ";
+            cin >> specificValue >> value;
+            list.insertBefore(specificValue, value);
+            break;
+        case 5:
+            cout << "Enter value to delete: ";
+            cin >> value;
+            list.deleteSpecific(value);
+            break;
+        case 6:
+            cout << "Enter value to search: ";
+            cin >> value;
+            cout << value << (list.search(value) ? " found" : " not found") << " in the list." << endl;
+            break;
+        case 7:
+            list.display();
+            cout << "Values: " << list.countNodes() << endl;
+            break;
+        case 8:
+            cout << "Exiting program." << endl;
+            break;
+        default:
+            cout << "Invalid choice. Please enter again." << endl;
+        }
+    } while (choice != 8);
+
+    return 0;
+}
+
+/**
+ * Usage Instructions:
+ * 1. Compile the program with C++17 (e.g., g++ -std=c++17 -O2 unrolled_linked_list.cpp -o unrolled_linked_list),
+ *    with node_pool.h in the same directory
+ * 2. Run the compiled executable (e.g., ./unrolled_linked_list)
+ * 3. Choose menu options to insert, delete, search and display values
+ *
+ * To compare with a one-int-per-node list, run ./unrolled_linked_list --benchmark [n]
+ */